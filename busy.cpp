@@ -20,93 +20,98 @@
 #include "constants.h"          // ⟪常量定义⟫
 #include "ctrl_disk_obj_req.h"  // ⟪控制器、磁盘、对象、请求相关⟫
 #include "data_analysis.h"      // ⟪数据分析相关⟫
+#include "token_table.h"        // ⟪令牌表⟫
 
 /*╔══════════════════════════════ 前置过滤实现 ══════════════════════════════╗
  * ┌──────────────────────────────────────────────────────────────────────┐
- * │ 功能：在请求加入前过滤低频率孤立请求                                    │
+ * │ 功能：在请求加入前拒绝预测无法在期限内完成的请求                        │
  * │ 策略：                                                                │
- * │ 1. 计算标签读取频率顺序                                                │
- * │ 2. 检测请求的邻居状态                                                  │
- * │ 3. 基于等待时间动态调整过滤阈值                                         │
+ * │ 1. 按主副本所在磁头的服务模型预测完成时间                              │
+ * │ 2. 超过磁头的准入期限才拒绝，能完成的请求一律接受                       │
+ * │ 3. 前置拒绝不计超时惩罚，优于等到后置过滤时才上报繁忙                    │
+ * │ 4. 时间预算降级到DL_GREEDY及以下时不做预测，请求全部接受               │
  * └──────────────────────────────────────────────────────────────────────┘
  */
 void Controller::pre_filter_req(std::vector<std::pair<int, int>> &reqs)
 {
-    // ◆ 初始化数据结构
-    std::vector<int> tag_order(M+1);                    // ● 标签读取频率次序
-    std::unordered_map<int, bool> req_is_alone;         // ● 请求邻居状态表
+    // ◆ 更新各磁头区域的到达率(每时间片调用一次)
+    for (int i = 1; i <= N; ++i) DISKS[i].update_arrival_rate();
+    if (time_budget.level >= DL_GREEDY) return;
 
-    // ◆ 计算标签读取频率次序
-    auto &order_tag = get_sorted_read_tag(this->timestamp);
-    for(int i = 0; i < M; ++i)
-    {
-        tag_order[order_tag[i]] = i;
-    }
-
-    // ◆ 分析请求邻居状态
-    for(auto [req_id, obj_id] : reqs)
-    {
-        int size = OBJECTS[obj_id].size;
-        int tag = OBJECTS[obj_id].tag;
-        Disk& disk = DISKS[OBJECTS[obj_id].replicas[0].first];
-        std::vector<int>& cell_idxs = OBJECTS[obj_id].replicas[0].second;
-
-        // ● 检查每个单元格的邻居
-        req_is_alone[req_id] = true;
-        for (auto &cell_idx : cell_idxs)
-        {
-            int prev_cell_idx = cell_idx;
-            int next_cell_idx = cell_idx;
-            // ● 检查前后7个单元格
-            for (int k = 0; k < 7; ++k)
-            {
-                if(disk.cells[prev_cell_idx].req_ids.size() > 0 or 
-                   disk.cells[next_cell_idx].req_ids.size() > 0)
-                {
-                    req_is_alone[req_id] = false; 
-                    break;
-                }
-                prev_cell_idx = prev_cell_idx == 1 ? 1 : prev_cell_idx - 1;
-                next_cell_idx = next_cell_idx == size ? size : next_cell_idx + 1;
-            }
-            if(not req_is_alone[req_id]) break;
-        }
-    }
-
-    // ◆ 动态过滤请求
     std::vector<std::pair<int, int>> new_reqs;
-    for(int i = 0; i < reqs.size(); ++i)
+    for (auto &[req_id, obj_id] : reqs)
     {
-        // ● 获取磁盘平均等待时间
-        Disk& disk = DISKS[OBJECTS[reqs[i].second].replicas[0].first];
-        float avg_wait_time = disk.get_avg_wait_time();
-
-        // ● 动态调整过滤阈值
-        int m = 12;
-        if(avg_wait_time > 43)      m -= 1;
-        else if(avg_wait_time > 29) m -= 2;
-        else if(avg_wait_time > 18) m -= 3;
-        else if(avg_wait_time > 16) m -= 4;
-        else if(avg_wait_time > 15) m -= 5;
-        else if(avg_wait_time > 14) m -= 6;
-        else if(avg_wait_time > 13) m -= 7;
-        else if(avg_wait_time > 11) m -= 7;
-        else if(avg_wait_time > 10) m -= 8;
-        else m = 0;
-
-        // ● 应用过滤条件
-        if(req_is_alone[reqs[i].first] and 
-           tag_order[OBJECTS[reqs[i].second].tag] < m)
+        const Object &obj = OBJECTS[obj_id];
+        const Disk &disk = DISKS[obj.replicas[0].first];
+        if (disk.predict_finish(obj.replicas[0].second) > disk.admit_limit(obj.replicas[0].second[0]))
         {
-            over_load_reqs.push_back(reqs[i].first);
+            over_load_reqs.push_back(req_id);
         }
         else
         {
-            new_reqs.push_back(reqs[i]);
+            new_reqs.push_back({req_id, obj_id});
         }
     }
     reqs = new_reqs;
 }
+
+/**
+ * @brief     预测读完一组单元所需的时间片数
+ * @param     units 待读单元格索引(新请求为整个主副本，在途请求为剩余单元)
+ * @return    预测时间片数
+ * @details   磁头沿地址递增方向在本区域内循环扫描，每时间片G个令牌:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 取对象最远单元到磁头的前向距离d，区域内待读单元按均匀分布估计，    │
+ * │    前方待读单元数 = 区域待读单元数 × d / 区域长度                      │
+ * │ 2. 前方待读单元按磁头每读取单元平均令牌计价，该均值由实际读取路径的   │
+ * │    连续读长度决定                                                    │
+ * │ 3. 对象自身单元按邻域待读密度插值：邻域密集时按连续读稳态令牌计价，   │
+ * │    孤立时按从80令牌新起一段读取的代价计价                            │
+ * │ 4. 待读单元之间的空隙逐格pass计1令牌，空隙超过G时按一次跳转计G令牌    │
+ * │ 5. 等待期间新到达且落在磁头与对象之间的单元先于对象读取，平均占前方   │
+ * │    距离的一半，按到达率从每时间片G令牌中扣除；扣尽则视为无法完成       │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+double Disk::predict_finish(const std::vector<int> &units) const
+{
+    int unit_num = units.size();
+    int region = head_region(units[0]);
+    if (region == 0) return 0;
+    int point = region == 1 ? point1 : point2;
+    double read_cost = region == 1 ? read_cost1 : read_cost2;
+    int region_start = region == 1 ? 1 : data_size1 + 1;
+    int region_len = region == 1 ? data_size1 : data_size2;
+    int region_end = region_start + region_len - 1;
+
+    // ◆ 对象最远单元到磁头的前向距离
+    int head = point >= region_start and point <= region_end ? point - region_start : 0;
+    int distance = 0;
+    for (int cell_idx : units)
+    {
+        distance = std::max(distance, (cell_idx - region_start - head + region_len) % region_len + 1);
+    }
+
+    // ◆ 对象自身单元：邻域越密越接近连续读稳态令牌，孤立时按新起一段读取计价
+    auto [min_it, max_it] = std::minmax_element(units.begin(), units.end());
+    int lo = std::max(region_start, *min_it - ADMIT_NEIGHBOR_WIDTH);
+    int hi = std::min(region_end, *max_it + ADMIT_NEIGHBOR_WIDTH);
+    int window = hi - lo + 1 - unit_num;
+    double density = window > 0 ? std::min(1.0, static_cast<double>(pending_map.count(lo, hi)) / window) : 1.0;
+    double fresh_cost = 0;
+    for (int token = 80, u = 0; u < unit_num; ++u)
+    {
+        token = get_next_token(token);
+        fresh_cost += token;
+    }
+    double own_cost = density * unit_num * get_next_token(16) + (1 - density) * fresh_cost;
+
+    // ◆ 前方待读单元与空隙的令牌代价
+    double ahead = static_cast<double>(pending_map.count(region_start, region_end)) * distance / region_len;
+    double gap = (distance - ahead) / (ahead + 1);
+    double tokens = ahead * read_cost + own_cost + (ahead + 1) * std::min<double>(gap, G);
+    double service = G - arrival_rate[region] * read_cost * distance / (2.0 * region_len);
+    return service > 0 ? tokens / service : INFINITY;
+}
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
 /*╔══════════════════════════════ 后置过滤实现 ══════════════════════════════╗
@@ -114,7 +119,7 @@ void Controller::pre_filter_req(std::vector<std::pair<int, int>> &reqs)
  * │ 功能：清理已超时或即将超时的请求                                        │
  * │ 策略：                                                                │
  * │ 1. 检查请求的生存时间                                                  │
- * │ 2. 移除超过104个时间片的请求                                           │
+ * │ 2. 移除超过REQ_KEEP_TIME个时间片的请求                                 │
  * │ 3. 更新系统状态和计数器                                                │
  * └──────────────────────────────────────────────────────────────────────┘
  */
@@ -133,7 +138,7 @@ void Controller::post_filter_req()
             continue;
         }
         // ● 移除超时请求
-        else if (birth_time + 104 < timestamp)
+        else if (birth_time + REQ_KEEP_TIME < timestamp)
         {
             busy_reqs.push_back(req_105_idx);
             remove_req(req_105_idx);
@@ -54,6 +54,78 @@ inline const int IS_EXTEND = 1;
 inline int const START_TAG = 3;
 inline int const WRITE_START = 10;
 
+/**
+ * @brief     分区边界迁移参数
+ * @details   相邻分区尾部相对时的动态边界调整:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ BOUNDARY_FULL_RATE: 分区空闲率低于该值时触发迁移                      │
+ * │ BOUNDARY_DONOR_RATE: 邻居分区迁移后需保留的最低空闲率                 │
+ * │ BOUNDARY_STEP_RATE: 单次迁移单元数占本分区大小的比例                  │
+ * │ BOUNDARY_MIN_STEP: 单次迁移的最少单元数                               │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+inline const float BOUNDARY_FULL_RATE = 0.03;
+inline const float BOUNDARY_DONOR_RATE = 0.25;
+inline const float BOUNDARY_STEP_RATE = 0.05;
+inline const int BOUNDARY_MIN_STEP = 5;
+
+/**
+ * @brief     请求时延统计参数
+ * @details   时延直方图衰减窗口每时间片的保留系数，0.99对应约100个时间片的窗口
+ */
+inline const double LATENCY_DECAY = 0.99;
+
+/**
+ * @brief     GC规划参数
+ * @details   先枚举候选交换并按收益选择，再执行:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ GC_STRAY_PENALTY: 对象单元位于非本标签分区时，折算的扫描单元数        │
+ * │ GC_PLAN_BUDGET_RATES: 每个(阶段, 分区)候选尝试的K预算比例            │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+inline const float GC_STRAY_PENALTY = 8.0;
+inline const std::vector<float> GC_PLAN_BUDGET_RATES = {0.5, 1.0};
+
+/**
+ * @brief     GC热度聚簇参数
+ * @details   按对象热度在分区内重排同尺寸对象，使热对象靠近磁头进入端:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ HEAT_DECAY: 对象读取热度每时间片的衰减系数                            │
+ * │ HEAT_PENDING_WEIGHT: 每个未完成请求折算的热度                         │
+ * │ GC_HEAT_MIN_GAIN: 交换两对象所需的最小热度差                          │
+ * │ GC_HEAT_RATE: 热度聚簇最多使用的K比例                                 │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+inline const double HEAT_DECAY = 0.999;
+inline const double HEAT_PENDING_WEIGHT = 4.0;
+inline const double GC_HEAT_MIN_GAIN = 1.0;
+inline const float GC_HEAT_RATE = 0.25;
+
+/**
+ * @brief     GC并行参数
+ * @details   GC_MAX_WORKERS: 并行GC的最大线程数(实际取硬件并发数与N的较小者)
+ */
+inline const int GC_MAX_WORKERS = 8;
+
+/**
+ * @brief     时间预算参数
+ * @details   每轮计划耗时按时间片均摊，累计耗时超前时逐级降级，有余量时逐级恢复:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ TIME_BUDGET_ROUND_MS: 每轮计划耗时，低于判题器限时并留有余量           │
+ * │ TIME_BUDGET_TICK_MS: 单个时间片耗时上限，超出时不等间隔立即降一级      │
+ * │ TIME_STEP_DOWN_RATE: 累计耗时超过计划的该比例时降一级                  │
+ * │ TIME_STEP_UP_RATE: 累计耗时低于计划的该比例时升一级                    │
+ * │ TIME_SWITCH_HOLD: 按累计耗时切换的最小间隔(时间片)                     │
+ * │ GC_MATCH_LIGHT_LIMIT: 降级后子集匹配最多装入的候选对象数               │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+inline const double TIME_BUDGET_ROUND_MS = 120000.0;
+inline const double TIME_BUDGET_TICK_MS = 1000.0;
+inline const double TIME_STEP_DOWN_RATE = 1.0;
+inline const double TIME_STEP_UP_RATE = 0.7;
+inline const int TIME_SWITCH_HOLD = 100;
+inline const int GC_MATCH_LIGHT_LIMIT = 64;
+
 /**
  * @brief     系统常量
  * @details   系统运行的限制与阈值:
@@ -70,6 +142,7 @@ inline int const WRITE_START = 10;
  * │ LEN_REQ: 请求循环缓冲区长度                                          │
  * │ REP_NUM: 副本数量                                                    │
  * │ EXTRA_TIME: 额外时间                                                 │
+ * │ REQ_KEEP_TIME: 后置过滤保留请求的最大年龄，超过即上报繁忙              │
  * │ MAX_G: 最大令牌数                                                    │
  * └──────────────────────────────────────────────────────────────────────┘
  */
@@ -85,7 +158,28 @@ inline const int MAX_OBJECT_NUM = (100000 + 1);
 inline const int LEN_REQ = 1000000;
 inline const int REP_NUM = 3;
 inline const int EXTRA_TIME = 105;
+inline const int REQ_KEEP_TIME = EXTRA_TIME - 1;
 inline const int MAX_G = 1000;
+
+/**
+ * @brief     请求准入参数
+ * @details   按磁头服务模型预测新请求的完成时间，超过期限才拒绝:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ ADMIT_DEADLINE: 预测完成所需时间片超过该值时前置拒绝，取后置过滤仍保留 │
+ * │                 的最大请求年龄REQ_KEEP_TIME                          │
+ * │ ADMIT_READ_COST_INIT: 每读取单元平均令牌的初值                        │
+ * │ ADMIT_READ_COST_RATE: 每读取单元平均令牌的指数滑动平均系数            │
+ * │ ADMIT_ARRIVAL_RATE: 每时间片新增待读单元数的指数滑动平均系数          │
+ * │ ADMIT_NEIGHBOR_WIDTH: 估计对象邻域待读密度时向两侧扩展的单元数        │
+ * │ ADMIT_TAIL_TARGET: 磁头p99时延超过该值时按超出量收紧准入期限          │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+inline const int ADMIT_DEADLINE = REQ_KEEP_TIME;
+inline const double ADMIT_READ_COST_INIT = 32.0;
+inline const double ADMIT_READ_COST_RATE = 0.1;
+inline const double ADMIT_ARRIVAL_RATE = 0.05;
+inline const int ADMIT_NEIGHBOR_WIDTH = 7;
+inline const int ADMIT_TAIL_TARGET = 85;
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
 /*╔══════════════════════════════ 标签数据定义 ═══════════════════════════════╗*/
@@ -19,6 +19,8 @@
 
 #include "ctrl_disk_obj_req.h"  // ⟪控制器、磁盘、对象、请求相关⟫
 #include <climits>              // ⟪系统限制常量⟫
+#include <algorithm>
+#include <tuple>
 
 /*╔══════════════════════════════ 请求处理实现 ══════════════════════════════╗
  * ┌──────────────────────────────────────────────────────────────────────┐
@@ -35,6 +37,11 @@ void Controller::add_req(int req_id, int obj_id)
     REQS[req_id % LEN_REQ].init(req_id, OBJECTS[obj_id], timestamp);  // ● 初始化请求
     OBJECTS[obj_id].req_ids.insert(req_id);                           // ● 关联对象
 
+    // ◆ 更新对象读取热度
+    Object &obj = OBJECTS[obj_id];
+    obj.heat = obj.heat * std::pow(HEAT_DECAY, timestamp - obj.heat_time) + 1;
+    obj.heat_time = timestamp;
+
     // ◆ 更新活跃请求范围
     assert(req_id > req_new_idx);
     req_new_idx = req_id;
@@ -43,7 +50,9 @@ void Controller::add_req(int req_id, int obj_id)
     auto &[disk_id, cells_idx] = OBJECTS[obj_id].replicas[0];
     for (int cell_idx : cells_idx)
     {
-        DISKS[disk_id].cells[cell_idx].req_ids.insert(req_id);
+        Disk &disk = DISKS[disk_id];
+        if (disk.cells[cell_idx].req_ids.empty()) disk.mark_pending(cell_idx);
+        disk.cells[cell_idx].req_ids.insert(req_id);
     }
 }
 
@@ -69,7 +78,11 @@ void Controller::remove_req(int req_id)
     auto &[disk_id, cells_idx] = OBJECTS[obj_id].replicas[0];
     for (int cell_idx : cells_idx)
     {
-        DISKS[disk_id].cells[cell_idx].req_ids.erase(req_id);
+        Disk &disk = DISKS[disk_id];
+        if (disk.cells[cell_idx].req_ids.erase(req_id) and disk.cells[cell_idx].req_ids.empty())
+        {
+            disk.unmark_pending(cell_idx);
+        }
     }
 }
 
@@ -82,47 +95,170 @@ void Controller::remove_req(int req_id)
  * │ - first_or_best: 是否返回首个匹配块                                    │
  * └──────────────────────────────────────────────────────────────────────┘
  */
-FreeBlock* Part::_find_best_block(int target_size, bool is_reverse, bool first_or_best) 
+int Part::_find_best_block(int target_size, bool is_reverse, bool first_or_best) 
 {
     // ◆ 验证链表状态
-    assert(free_list_head != nullptr or free_cells == 0);
-    if(free_list_head != nullptr ) assert(free_list_head->prev == nullptr);
-    assert(free_list_tail != nullptr or free_cells == 0);
-    if(free_list_tail != nullptr) assert(free_list_tail->next == nullptr);
-    assert(tag != 0);
+    assert(free_list_head != FreeBlock::NIL or free_cells == 0);
+    if(free_list_head != FreeBlock::NIL) assert(block(free_list_head).prev == FreeBlock::NIL);
+    assert(free_list_tail != FreeBlock::NIL or free_cells == 0);
+    if(free_list_tail != FreeBlock::NIL) assert(block(free_list_tail).next == FreeBlock::NIL);
 
     // ◆ 查找最佳匹配块
-    FreeBlock* current = is_reverse ? free_list_tail : free_list_head;
+    int current = is_reverse ? free_list_tail : free_list_head;
     int best_diff = INT_MAX;
-    FreeBlock* best_block = nullptr;
+    int best_block = FreeBlock::NIL;
 
-    while (current != nullptr) 
+    while (current != FreeBlock::NIL) 
     {
         // ● 计算大小差异
-        int diff = current->end - current->start + 1 - target_size;
+        const FreeBlock& cur = block(current);
+        int diff = cur.end - cur.start + 1 - target_size;
         if (diff >= 0 && diff < best_diff) 
         {
             if(first_or_best) return current;
             best_diff = diff;
             best_block = current;
         }
-        current = is_reverse ? current->prev : current->next;
+        current = is_reverse ? cur.prev : cur.next;
+    }
+    return best_block;
+}
+
+/*╔════════════════════════════ 首个匹配查找实现 ═══════════════════════════════╗
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 功能：与沿链表方向遍历取首个可容纳块等价，但只查长度桶的首尾元素        │
+ * │ 策略：长度不小于size的每个桶，正向取起始位置最小的块，反向取最大的块，   │
+ * │       各桶结果中再取方向上最靠前者                                      │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+int Part::_find_first_block(int size, bool is_reverse) const
+{
+    assert(size >= 1 and size <= FIT_BUCKETS);
+    int best_start = is_reverse ? INT_MIN : INT_MAX;
+    int best_block = FreeBlock::NIL;
+    for (int b = _fit_bucket(size); b < FIT_BUCKETS; ++b)
+    {
+        const auto &bucket = start_index[b];
+        if (bucket.empty()) continue;
+        const auto &[block_start, idx] = is_reverse ? *bucket.rbegin() : *bucket.begin();
+        if (is_reverse ? block_start > best_start : block_start < best_start)
+        {
+            best_start = block_start;
+            best_block = idx;
+        }
     }
     return best_block;
 }
 
+/*╔════════════════════════════ 连续区段分配实现 ═══════════════════════════════╗
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 功能：为对象分配写入位置，尽量保证连续                                 │
+ * │ 策略：                                                               │
+ * │ 1. 最佳匹配：按大小索引取最小可容纳块，O(log 空闲块数)                 │
+ * │    同长度时取方向上最靠前的块(正向取低地址，反向取高地址)              │
+ * │ 2. 首个匹配：按长度桶取方向上首个可容纳块，O(桶数×log 空闲块数)，       │
+ * │    用于从尾部写入外来对象                                             │
+ * │ 3. 无可容纳块：按块从大到小选取，碎片数最少，再按方向排列              │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+std::vector<int> Part::allocate_run(int size, bool is_reverse, bool first_fit)
+{
+    assert(size > 0 and size <= free_cells);
+
+    std::vector<int> positions;
+    int target = FreeBlock::NIL;
+
+    // ◆ 查找可完整容纳的空闲块
+    if (first_fit)
+    {
+        target = _find_first_block(size, is_reverse);
+    }
+    else
+    {
+        auto it = size_index.lower_bound({size, INT_MIN});
+        if (it != size_index.end())
+        {
+            // ● 反向时取同长度中起始位置最大的块
+            if (is_reverse) it = std::prev(size_index.upper_bound({it->first.first, INT_MAX}));
+            target = it->second;
+        }
+    }
+
+    // ◆ 连续写入
+    if (target != FreeBlock::NIL)
+    {
+        _take_from_block(target, size, is_reverse, positions);
+        return positions;
+    }
+
+    // ◆ 拆分写入：从大到小选块
+    std::vector<std::tuple<int, int, int>> chosen;   // (起始位置, 节点索引, 截取数量)
+    int remain = size;
+    for (auto it = size_index.rbegin(); it != size_index.rend() and remain > 0; ++it)
+    {
+        int count = std::min(it->first.first, remain);
+        chosen.push_back({it->first.second, it->second, count});
+        remain -= count;
+    }
+    assert(remain == 0);
+
+    // ● 按写入方向排列，使对象单元顺序与磁头移动方向一致
+    std::sort(chosen.begin(), chosen.end());
+    if (is_reverse) std::reverse(chosen.begin(), chosen.end());
+    for (auto &[block_start, idx, count] : chosen)
+    {
+        _take_from_block(idx, count, is_reverse, positions);
+    }
+    return positions;
+}
+
+/*╔════════════════════════════ 空闲块截取实现 ═══════════════════════════════╗
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 功能：从空闲块一侧截取若干单元，截空则移除该块                          │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+void Part::_take_from_block(int idx, int count, bool from_end, std::vector<int>& positions)
+{
+    FreeBlock& cur = block(idx);
+    assert(count > 0 and count <= cur.end - cur.start + 1);
+
+    // ◆ 记录截取位置
+    for (int i = 0; i < count; ++i)
+    {
+        positions.push_back(from_end ? cur.end - i : cur.start + i);
+    }
+
+    // ◆ 更新空闲块
+    if (count == cur.end - cur.start + 1)
+    {
+        _remove_free_block(idx);
+        return;
+    }
+    _unindex_block(idx);
+    if (from_end) cur.end -= count;
+    else cur.start += count;
+    _index_block(idx);
+}
+
 /*╔════════════════════════════ 空闲链表初始化 ═══════════════════════════════╗
  * ┌──────────────────────────────────────────────────────────────────────┐
  * │ 功能：初始化分区的空闲块链表                                           │
  * │ 步骤：                                                               │
- * │ 1. 检查空闲单元数量                                                   │
- * │ 2. 标准化分区范围                                                     │
- * │ 3. 创建初始空闲块                                                     │
+ * │ 1. 绑定磁盘节点池                                                     │
+ * │ 2. 检查空闲单元数量                                                   │
+ * │ 3. 标准化分区范围                                                     │
+ * │ 4. 创建初始空闲块                                                     │
  * └──────────────────────────────────────────────────────────────────────┘
  */
-void Part::init_free_list() 
+void Part::init_free_list(FreeBlockPool* pool) 
 {
-    assert(tag != 0);
+    assert(pool != nullptr);
+
+    // ◆ 绑定节点池
+    this->pool = pool;
+    free_list_head = FreeBlock::NIL;
+    free_list_tail = FreeBlock::NIL;
+    _clear_block_index();
     
     // ◆ 检查空闲单元
     if (free_cells <= 0) return;
@@ -132,8 +268,27 @@ void Part::init_free_list()
     int max_pos = std::max(start, end);
     
     // ◆ 创建初始空闲块
-    free_list_head = new FreeBlock(min_pos, max_pos);
+    free_list_head = pool->alloc(min_pos, max_pos);
     free_list_tail = free_list_head;
+    _index_block(free_list_head);
+}
+
+/**
+ * @brief     在链表尾部追加空闲块
+ * @param     start_pos 起始位置
+ * @param     end_pos 结束位置
+ */
+void Part::append_free_block(int start_pos, int end_pos)
+{
+    assert(pool != nullptr and start_pos <= end_pos);
+    assert(free_list_tail == FreeBlock::NIL or block(free_list_tail).end < start_pos);
+
+    int idx = pool->alloc(start_pos, end_pos);
+    block(idx).prev = free_list_tail;
+    if (free_list_tail == FreeBlock::NIL) free_list_head = idx;
+    else block(free_list_tail).next = idx;
+    free_list_tail = idx;
+    _index_block(idx);
 }
 
 /*╔════════════════════════════ 空闲块分配实现 ═══════════════════════════════╗
@@ -148,11 +303,10 @@ void Part::init_free_list()
 void Part::allocate_block(int pos) 
 {
     // ◆ 状态验证
-    assert(tag != 0);
-    assert(free_list_head != nullptr or free_cells == 0);
-    if(free_list_head != nullptr ) assert(free_list_head->prev == nullptr);
-    assert(free_list_tail != nullptr or free_cells == 0);
-    if(free_list_tail != nullptr) assert(free_list_tail->next == nullptr);
+    assert(free_list_head != FreeBlock::NIL or free_cells == 0);
+    if(free_list_head != FreeBlock::NIL) assert(block(free_list_head).prev == FreeBlock::NIL);
+    assert(free_list_tail != FreeBlock::NIL or free_cells == 0);
+    if(free_list_tail != FreeBlock::NIL) assert(block(free_list_tail).next == FreeBlock::NIL);
     
     // ◆ 验证位置有效性
     int min_pos = std::min(start, end);
@@ -160,56 +314,65 @@ void Part::allocate_block(int pos)
     assert(pos >= min_pos && pos <= max_pos);
     
     // ◆ 查找目标块
-    FreeBlock* current = free_list_head;
-    assert(current != nullptr);
+    int current = free_list_head;
+    assert(current != FreeBlock::NIL);
     
-    while (current != nullptr) 
+    while (current != FreeBlock::NIL) 
     {
-        assert(current->start <= current->end);
-        if (current->start <= pos && current->end >= pos) 
+        FreeBlock& cur = block(current);
+        assert(cur.start <= cur.end);
+        if (cur.start <= pos && cur.end >= pos) 
         {
             // ● 处理单个单元块
-            if (current->start == pos && current->end == pos) 
+            if (cur.start == pos && cur.end == pos) 
             {
                 _remove_free_block(current);
                 return;
             }
             
             // ● 处理起始位置
-            if (current->start == pos) 
+            if (cur.start == pos) 
             {
-                current->start = pos + 1;
+                _unindex_block(current);
+                cur.start = pos + 1;
+                _index_block(current);
                 return;
             }
             
             // ● 处理结束位置
-            if (current->end == pos) 
+            if (cur.end == pos) 
             {
-                current->end = pos - 1;
+                _unindex_block(current);
+                cur.end = pos - 1;
+                _index_block(current);
                 return;
             }
             
-            // ● 处理中间位置
-            FreeBlock* new_block = new FreeBlock(pos + 1, current->end);
-            current->end = pos - 1;
+            // ● 处理中间位置(分配新节点后重新取引用，避免引用失效)
+            _unindex_block(current);
+            int new_block = pool->alloc(pos + 1, cur.end);
+            FreeBlock& split = block(current);
+            split.end = pos - 1;
             
             // ● 链接新块
-            new_block->next = current->next;
-            new_block->prev = current;
+            block(new_block).next = split.next;
+            block(new_block).prev = current;
             
-            if (current->next != nullptr) 
+            if (split.next != FreeBlock::NIL) 
             {
-                current->next->prev = new_block;
+                block(split.next).prev = new_block;
             } 
             else 
             {
                 free_list_tail = new_block;
             }
             
-            current->next = new_block;
+            split.next = new_block;
+            _index_block(current);
+            _index_block(new_block);
             return;
         }
-        current = current->next;
+        current = cur.next;
     }
     assert(false and "找不到包含该位置的空闲块");
 }
@@ -226,11 +389,10 @@ void Part::allocate_block(int pos)
 void Part::free_block(int pos) 
 {
     // ◆ 状态验证
-    assert(tag != 0);
-    assert(free_list_head != nullptr or free_cells == 0);
-    if(free_list_head != nullptr ) assert(free_list_head->prev == nullptr);
-    assert(free_list_tail != nullptr or free_cells == 0);
-    if(free_list_tail != nullptr) assert(free_list_tail->next == nullptr);
+    assert(free_list_head != FreeBlock::NIL or free_cells == 0);
+    if(free_list_head != FreeBlock::NIL) assert(block(free_list_head).prev == FreeBlock::NIL);
+    assert(free_list_tail != FreeBlock::NIL or free_cells == 0);
+    if(free_list_tail != FreeBlock::NIL) assert(block(free_list_tail).next == FreeBlock::NIL);
 
     // ◆ 验证位置有效性
     int min_pos = std::min(start, end);
@@ -238,14 +400,12 @@ void Part::free_block(int pos)
     assert(pos >= min_pos && pos <= max_pos);
     
     // ◆ 检查重复释放
-    FreeBlock* current = free_list_head;
-    while (current != nullptr) 
+    for (int current = free_list_head; current != FreeBlock::NIL; current = block(current).next) 
     {
-        if (current->start <= pos && current->end >= pos) 
+        if (block(current).start <= pos && block(current).end >= pos) 
         {
             assert(false and "位置已经在空闲块中");
         }
-        current = current->next;
     }
     
     // ◆ 创建新空闲块
@@ -256,21 +416,21 @@ void Part::free_block(int pos)
  * ┌──────────────────────────────────────────────────────────────────────┐
  * │ 功能：在链表中插入新的空闲块                                           │
  * │ 步骤：                                                               │
- * │ 1. 创建新空闲块                                                      │
+ * │ 1. 从节点池分配新空闲块                                               │
  * │ 2. 查找插入位置                                                      │
- * │ 3. 更新链表指针                                                      │
+ * │ 3. 更新链表索引                                                      │
  * │ 4. 合并相邻块                                                        │
  * └──────────────────────────────────────────────────────────────────────┘
  */
 void Part::_insert_free_block(int start_pos, int end_pos) 
 {
-    assert(tag != 0);
     
     // ◆ 创建新块
-    FreeBlock* new_block = new FreeBlock(start_pos, end_pos);
+    int new_block = pool->alloc(start_pos, end_pos);
+    _index_block(new_block);
     
     // ◆ 处理空链表
-    if (free_list_head == nullptr) 
+    if (free_list_head == FreeBlock::NIL) 
     {
         free_list_head = new_block;
         free_list_tail = new_block;
@@ -278,36 +438,33 @@ void Part::_insert_free_block(int start_pos, int end_pos)
     }
     
     // ◆ 查找插入位置
-    FreeBlock* current = free_list_head;
-    FreeBlock* prev = nullptr;
+    int current = free_list_head;
+    int prev = FreeBlock::NIL;
     
-    while (current != nullptr && current->start < start_pos) 
+    while (current != FreeBlock::NIL && block(current).start < start_pos) 
     {
-        assert(current->start != start_pos);
+        assert(block(current).start != start_pos);
         prev = current;
-        current = current->next;
+        current = block(current).next;
     }
     
     // ◆ 插入新块
-    if (prev == nullptr) 
+    if (prev == FreeBlock::NIL) 
     {
         // ● 插入头部
-        new_block->next = free_list_head;
-        if (free_list_head != nullptr) 
-        {
-            free_list_head->prev = new_block;
-        }
+        block(new_block).next = free_list_head;
+        block(free_list_head).prev = new_block;
         free_list_head = new_block;
     } 
     else 
     {
         // ● 插入中间或尾部
-        new_block->prev = prev;
-        new_block->next = current;
-        prev->next = new_block;
-        if (current != nullptr) 
+        block(new_block).prev = prev;
+        block(new_block).next = current;
+        block(prev).next = new_block;
+        if (current != FreeBlock::NIL) 
         {
-            current->prev = new_block;
+            block(current).prev = new_block;
         } 
         else 
         {
@@ -323,37 +480,38 @@ void Part::_insert_free_block(int start_pos, int end_pos)
  * ┌──────────────────────────────────────────────────────────────────────┐
  * │ 功能：从链表中移除指定的空闲块                                         │
  * │ 步骤：                                                               │
- * │ 1. 更新前驱节点指针                                                   │
- * │ 2. 更新后继节点指针                                                   │
- * │ 3. 更新头尾指针                                                       │
+ * │ 1. 更新前驱节点索引                                                   │
+ * │ 2. 更新后继节点索引                                                   │
+ * │ 3. 更新头尾索引并归还节点                                             │
  * └──────────────────────────────────────────────────────────────────────┘
  */
-void Part::_remove_free_block(FreeBlock* block) 
+void Part::_remove_free_block(int idx) 
 {
-    assert(tag != 0);
-    if (block == nullptr) return;
+    if (idx == FreeBlock::NIL) return;
+    FreeBlock& cur = block(idx);
+    _unindex_block(idx);
     
-    // ◆ 更新链表指针
-    if (block->prev != nullptr) 
+    // ◆ 更新链表索引
+    if (cur.prev != FreeBlock::NIL) 
     {
-        block->prev->next = block->next;
+        block(cur.prev).next = cur.next;
     } 
     else 
     {
-        free_list_head = block->next;
+        free_list_head = cur.next;
     }
     
-    if (block->next != nullptr) 
+    if (cur.next != FreeBlock::NIL) 
     {
-        block->next->prev = block->prev;
+        block(cur.next).prev = cur.prev;
     } 
     else 
     {
-        free_list_tail = block->prev;
+        free_list_tail = cur.prev;
     }
     
-    // ◆ 释放内存
-    delete block;
+    // ◆ 归还节点
+    pool->release(idx);
 }
 
 /*╔════════════════════════════ 空闲块合并实现 ═══════════════════════════════╗
@@ -362,85 +520,170 @@ void Part::_remove_free_block(FreeBlock* block)
  * │ 步骤：                                                                │
  * │ 1. 检查并合并前向相邻块                                                │
  * │ 2. 检查并合并后向相邻块                                                │
- * │ 3. 更新链表结构                                                       │
+ * │ 3. 两侧均相邻时先并入前块再并入后块，保持链表规范                     │
  * └──────────────────────────────────────────────────────────────────────┘
  */
-void Part::_merge_adjacent_blocks(FreeBlock* block) 
+void Part::_merge_adjacent_blocks(int idx) 
 {
-    assert(tag != 0);
-    if (block == nullptr) return;
+    if (idx == FreeBlock::NIL) return;
+    FreeBlock& cur = block(idx);
     
     // ◆ 尝试前向合并
-    if (block->prev != nullptr && block->prev->end + 1 == block->start) 
+    if (cur.prev != FreeBlock::NIL && block(cur.prev).end + 1 == cur.start) 
     {
-        FreeBlock* prev_block = block->prev;
+        int prev_idx = cur.prev;
+        FreeBlock& prev_block = block(prev_idx);
         
         // ● 更新块边界
-        assert(prev_block->end < block->end);
-        prev_block->end = block->end;
+        assert(prev_block.end < cur.end);
+        _unindex_block(prev_idx);
+        _unindex_block(idx);
+        prev_block.end = cur.end;
+        _index_block(prev_idx);
         
         // ● 更新链表结构
-        prev_block->next = block->next;
-        if (block->next != nullptr) 
+        prev_block.next = cur.next;
+        if (cur.next != FreeBlock::NIL) 
         {
-            block->next->prev = prev_block;
+            block(cur.next).prev = prev_idx;
         } 
         else 
         {
-            free_list_tail = prev_block;
+            free_list_tail = prev_idx;
         }
         
-        // ● 释放内存
-        delete block;
-        return;
+        // ● 归还节点，继续以合并后的块尝试后向合并
+        pool->release(idx);
+        idx = prev_idx;
     }
     
     // ◆ 尝试后向合并
-    if (block->next != nullptr && block->end + 1 == block->next->start) 
+    FreeBlock& merged = block(idx);
+    if (merged.next != FreeBlock::NIL && merged.end + 1 == block(merged.next).start) 
     {
-        FreeBlock* next_block = block->next;
+        int next_idx = merged.next;
+        FreeBlock& next_block = block(next_idx);
         
         // ● 更新块边界
-        assert(block->end < next_block->end);
-        block->end = next_block->end;
+        assert(merged.end < next_block.end);
+        _unindex_block(idx);
+        _unindex_block(next_idx);
+        merged.end = next_block.end;
+        _index_block(idx);
         
         // ● 更新链表结构
-        block->next = next_block->next;
-        if (next_block->next != nullptr) 
+        merged.next = next_block.next;
+        if (next_block.next != FreeBlock::NIL) 
         {
-            next_block->next->prev = block;
+            block(next_block.next).prev = idx;
         } 
         else 
         {
-            free_list_tail = block;
+            free_list_tail = idx;
         }
         
-        // ● 释放内存
-        delete next_block;
+        // ● 归还节点
+        pool->release(next_idx);
     }
 }
 
 /*╔════════════════════════════ 空闲链表清理实现 ══════════════════════════════╗
  * ┌──────────────────────────────────────────────────────────────────────┐
- * │ 功能：清理空闲块链表并释放内存                                         │
+ * │ 功能：清理空闲块链表并归还节点                                         │
  * │ 步骤：                                                               │
- * │ 1. 遍历并释放所有节点                                                 │
- * │ 2. 重置链表头尾指针                                                   │
+ * │ 1. 遍历并归还所有节点                                                 │
+ * │ 2. 重置链表头尾索引                                                   │
  * └──────────────────────────────────────────────────────────────────────┘
  */
 void Part::_clear_free_list() 
 {
-    // ◆ 遍历释放节点
-    FreeBlock* current = free_list_head;
-    while (current != nullptr) 
+    // ◆ 遍历归还节点
+    int current = free_list_head;
+    while (current != FreeBlock::NIL) 
     {
-        FreeBlock* next = current->next;
-        delete current;
+        int next = block(current).next;
+        pool->release(current);
         current = next;
     }
 
-    // ◆ 重置指针
-    free_list_head = nullptr;
-    free_list_tail = nullptr;
+    // ◆ 重置索引
+    free_list_head = FreeBlock::NIL;
+    free_list_tail = FreeBlock::NIL;
+    _clear_block_index();
+}
+
+
+/*╔════════════════════════════ 空闲链表完整性校验 ═════════════════════════════╗
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 功能：校验链表自身结构，返回违例数(0表示通过)                           │
+ * │ 检查项：                                                             │
+ * │ 1. 头尾索引与prev/next双向链接一致                                     │
+ * │ 2. 块按起始位置严格递增，互不重叠且不相邻(相邻块应已合并)              │
+ * │ 3. 块位于分区范围内                                                   │
+ * │ 4. 大小索引、首个匹配索引与链表中的块一一对应                          │
+ * │ 5. 块长度之和等于free_cells                                           │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+int Part::_verify_free_list_integrity()
+{
+    int errors = 0;
+    int min_pos = std::min(start, end);
+    int max_pos = std::max(start, end);
+
+    // ◆ 沿链表检查链接、顺序与范围
+    int total = 0;
+    int count = 0;
+    int prev = FreeBlock::NIL;
+    for (int idx = free_list_head; idx != FreeBlock::NIL; idx = block(idx).next)
+    {
+        const FreeBlock &cur = block(idx);
+        if (cur.prev != prev) errors++;
+        if (cur.start > cur.end or cur.start < min_pos or cur.end > max_pos) errors++;
+        if (prev != FreeBlock::NIL and block(prev).end + 1 >= cur.start) errors++;
+
+        auto it = size_index.find({cur.end - cur.start + 1, cur.start});
+        if (it == size_index.end() or it->second != idx) errors++;
+        if (start_index[_fit_bucket(cur.end - cur.start + 1)].count({cur.start, idx}) == 0) errors++;
+
+        total += cur.end - cur.start + 1;
+        count++;
+        prev = idx;
+    }
+    if (free_list_tail != prev) errors++;
+
+    // ◆ 检查索引规模与空闲计数
+    if (static_cast<int>(size_index.size()) != count) errors++;
+    size_t bucket_total = 0;
+    for (auto &bucket : start_index) bucket_total += bucket.size();
+    if (static_cast<int>(bucket_total) != count) errors++;
+    if (total != free_cells) errors++;
+    return errors;
 }
 
+/*╔════════════════════════════ 空闲链表一致性校验 ═════════════════════════════╗
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 功能：校验链表与磁盘单元格状态一致，返回违例数(0表示通过)               │
+ * │ 检查项：                                                             │
+ * │ 1. 分区范围内单元格均归属本分区                                        │
+ * │ 2. 单元格空闲当且仅当被某个空闲块覆盖                                  │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+int Part::_verify_free_list_consistency(Disk* disk)
+{
+    int errors = 0;
+    int min_pos = std::min(start, end);
+    int max_pos = std::max(start, end);
+
+    int idx = free_list_head;
+    for (int pos = min_pos; pos <= max_pos; ++pos)
+    {
+        const Cell &cell = disk->cells[pos];
+        if (cell.part != this) errors++;
+
+        // ● 跳过已在当前位置之前结束的块
+        while (idx != FreeBlock::NIL and block(idx).end < pos) idx = block(idx).next;
+        bool in_block = idx != FreeBlock::NIL and block(idx).start <= pos;
+        if (in_block != (cell.obj_id == 0)) errors++;
+    }
+    return errors;
+}
@@ -20,10 +20,14 @@
 #pragma once
 #include "constants.h"       // 系统常量
 #include "tools.h"           // 工具类
+#include "stats.h"           // 统计信息
 #include <vector>
 #include <unordered_set>
 #include <cassert>
-#include <deque>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <cmath>
 
 /*╔══════════════════════════════ 前向声明 ═══════════════════════════════╗*/
 class Controller;    // 系统控制器
@@ -70,6 +74,10 @@ public:
     int busy_count = 0;            // 被动过滤请求计数
     int over_load_count = 0;       // 主动过滤请求计数
     int write_count = 0;           // 写入计数
+    WriteStats write_stats;        // 写入放置统计
+    TickStats tick_stats;          // 时间片耗时统计
+    TimeBudget time_budget;        // 时间预算与降级等级
+    LatencyHist tag_wait_hist[MAX_TAG_NUM + 1]; // 各标签完成请求的时延直方图
 
     /**
      * @brief 控制器构造函数
@@ -128,15 +136,51 @@ public:
      * @details 根据磁盘负载动态过滤请求
      */
     void pre_filter_req(std::vector<std::pair<int, int>> &reqs);
+
+    /**
+     * @brief 并行执行所有磁盘的垃圾回收
+     * @return 按磁盘编号排列的交换对
+     */
+    std::vector<std::vector<std::pair<int, int>>> gc();
+
+    /**
+     * @brief 保存完整控制器状态的二进制快照
+     * @param path 快照文件路径
+     */
+    void save_state(const std::string &path);
+
+    /**
+     * @brief 映射二进制快照并恢复完整控制器状态
+     * @param path 快照文件路径
+     * @return 是否加载成功
+     */
+    bool load_state(const std::string &path);
+
+    /**
+     * @brief 输出本轮各磁盘、磁头和标签的请求时延分布
+     * @param round 轮次
+     */
+    void dump_latency(int round) const;
     
 private:
     /**
      * @brief 选择写入磁盘和分区
      * @param obj_size 对象大小
      * @param tag 对象标签
+     * @param strategy 命中的策略
+     * @param scan_steps 检查的分区数
      * @return 磁盘ID和分区指针对
      */
-    std::vector<std::pair<int, Part*>> _get_write_disk(int obj_size, int tag);
+    std::vector<std::pair<int, Part*>> _get_write_disk(int obj_size, int tag, 
+                                                       WriteStrategy &strategy, int &scan_steps);
+
+    /**
+     * @brief 记录写入放置统计
+     * @param obj 已写入的对象
+     * @param strategy 命中的策略
+     * @param scan_steps 检查的分区数
+     */
+    void _record_write_stats(const Object &obj, WriteStrategy strategy, int scan_steps);
 };
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
@@ -182,27 +226,99 @@ struct Cell
  * @details   管理连续空闲空间的双向链表节点:
  * ┌──────────────────────────────────────────────────────────────────────┐
  * │ 1. 位置信息：空闲块的起始和结束位置                                   │
- * │ 2. 链表指针：前后空闲块的连接                                        │
+ * │ 2. 链表索引：前后空闲块在节点池中的下标(侵入式链接)                   │
  * └──────────────────────────────────────────────────────────────────────┘
  */
 struct FreeBlock 
 {
+    static const int NIL = -1; // 空索引
+
     int start;                // 空闲块起始位置
     int end;                  // 空闲块结束位置
-    FreeBlock* prev;          // 前一个空闲块
-    FreeBlock* next;          // 后一个空闲块
+    int prev;                 // 前一个空闲块索引
+    int next;                 // 后一个空闲块索引
     
     /**
      * @brief 默认构造函数
      */
-    FreeBlock() : start(0), end(0), prev(nullptr), next(nullptr) {}
+    FreeBlock() : start(0), end(0), prev(NIL), next(NIL) {}
     
     /**
      * @brief 带参数构造函数
      * @param s 起始位置
      * @param e 结束位置
      */
-    FreeBlock(int s, int e) : start(s), end(e), prev(nullptr), next(nullptr) {}
+    FreeBlock(int s, int e) : start(s), end(e), prev(NIL), next(NIL) {}
+};
+
+/**
+ * @brief     空闲块节点池
+ * @details   每个磁盘独占一个节点池，替代逐个new/delete:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 连续存储：节点存放于vector，按初始化时的上界预留，不再扩容         │
+ * │ 2. 回收复用：释放的节点经next串成回收链表，分配时优先复用            │
+ * │ 3. 整体释放：轮次重置与析构时一次性清空，不逐节点遍历                 │
+ * │ 4. 统计信息：记录当前存活节点数与峰值                                 │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class FreeBlockPool
+{
+public:
+    std::vector<FreeBlock> nodes;      // 节点存储
+    int recycle_head = FreeBlock::NIL; // 回收链表头
+    int live_count = 0;                // 存活节点数
+    int peak_count = 0;                // 存活节点峰值
+
+    /**
+     * @brief 整体重置节点池
+     * @param capacity 预留节点数
+     */
+    void reset(int capacity)
+    {
+        nodes.clear();
+        nodes.reserve(capacity);
+        recycle_head = FreeBlock::NIL;
+        live_count = 0;
+        peak_count = 0;
+    }
+
+    /**
+     * @brief 分配节点
+     * @param s 起始位置
+     * @param e 结束位置
+     * @return 节点索引
+     */
+    int alloc(int s, int e)
+    {
+        int idx = recycle_head;
+        if (idx != FreeBlock::NIL)
+        {
+            recycle_head = nodes[idx].next;
+            nodes[idx] = FreeBlock(s, e);
+        }
+        else
+        {
+            idx = static_cast<int>(nodes.size());
+            nodes.emplace_back(s, e);
+        }
+        peak_count = std::max(peak_count, ++live_count);
+        return idx;
+    }
+
+    /**
+     * @brief 归还节点
+     * @param idx 节点索引
+     */
+    void release(int idx)
+    {
+        assert(idx != FreeBlock::NIL and live_count > 0);
+        nodes[idx].prev = FreeBlock::NIL;
+        nodes[idx].next = recycle_head;
+        recycle_head = idx;
+        live_count--;
+    }
+
+    FreeBlock& operator[](int idx) { return nodes[idx]; }
 };
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
@@ -226,29 +342,55 @@ public:
     int last_write_pos;        // 上次写入位置
     int tag;                   // 分区标签
     int size;                  // 分区大小
-    FreeBlock* free_list_head; // 空闲块链表头指针
-    FreeBlock* free_list_tail; // 空闲块链表尾指针
+    FreeBlockPool* pool;       // 所属磁盘的空闲块节点池
+    int free_list_head;        // 空闲块链表头索引
+    int free_list_tail;        // 空闲块链表尾索引
 
-    // 当前分区内不属于该分区的对象
-    std::vector<int> other_objs;
+    // 空闲块大小索引：(长度, 起始位置) -> 节点索引，与链表同步维护
+    std::map<std::pair<int, int>, int> size_index;
+
+    // 空闲块首个匹配索引：按长度分桶(1..FIT_BUCKETS-1各一桶，其余归最后一桶)，
+    // 桶内(起始位置, 节点索引)有序，与链表同步维护
+    static const int FIT_BUCKETS = 5;
+    std::set<std::pair<int, int>> start_index[FIT_BUCKETS];
+
+    // 当前分区内不属于该分区的对象(按单元引用计数，随写入、删除、交换增量维护)
+    IndexedSet other_objs;
 
     /**
      * @brief 默认构造函数
      */
     Part() : start(0), end(0), free_cells(0), last_write_pos(0), tag(0), size(0), 
-             free_list_head(nullptr), free_list_tail(nullptr) {}
+             pool(nullptr), free_list_head(FreeBlock::NIL), free_list_tail(FreeBlock::NIL) {}
     
     /**
      * @brief 带参数构造函数
      */
     Part(int start, int end, int free_cells, int last_write_pos, int tag, int size) : 
          start(start), end(end), free_cells(free_cells), last_write_pos(last_write_pos), 
-         tag(tag), size(size), free_list_head(nullptr), free_list_tail(nullptr) {}
+         tag(tag), size(size), pool(nullptr), 
+         free_list_head(FreeBlock::NIL), free_list_tail(FreeBlock::NIL) {}
+
+    /**
+     * @brief 获取空闲块节点
+     * @param idx 节点索引
+     * @return 节点引用
+     */
+    FreeBlock& block(int idx) { return (*pool)[idx]; }
 
     /**
      * @brief 初始化空闲块链表
+     * @param pool 所属磁盘的节点池
+     */
+    void init_free_list(FreeBlockPool* pool);
+
+    /**
+     * @brief 在链表尾部追加空闲块(状态快照恢复用)
+     * @param start_pos 起始位置
+     * @param end_pos 结束位置
+     * @details 调用方保证按地址升序追加；不修改free_cells
      */
-    void init_free_list();
+    void append_free_block(int start_pos, int end_pos);
     
     /**
      * @brief 分配空闲块
@@ -257,6 +399,17 @@ public:
      */
     void allocate_block(int pos);
     
+    /**
+     * @brief 分配连续区段
+     * @param size 单元数
+     * @param is_reverse 是否从分区高地址侧写入
+     * @param first_fit 是否沿方向取首个可容纳的空闲块(否则取最佳匹配)
+     * @return 按写入顺序排列的单元位置
+     * @details 存在可容纳的空闲块时保证连续；否则按块从大到小拆分，
+     *          使碎片数最少。仅维护链表，不影响原有free_cells
+     */
+    std::vector<int> allocate_run(int size, bool is_reverse, bool first_fit);
+
     /**
      * @brief 释放块
      * @param pos 位置
@@ -266,7 +419,7 @@ public:
 
     /**
      * @brief 清理空闲块链表
-     * @details 释放内存
+     * @details 节点逐个归还节点池
      */
     void _clear_free_list();
 
@@ -275,20 +428,20 @@ public:
      * @param target_size 目标大小
      * @param is_reverse 是否反向查找
      * @param first_or_best 是否优先查找
-     * @return 找到的空闲块指针
+     * @return 找到的空闲块索引，未找到为FreeBlock::NIL
      */
-    FreeBlock* _find_best_block(int target_size, bool is_reverse, bool first_or_best);
+    int _find_best_block(int target_size, bool is_reverse, bool first_or_best);
 
     /**
-     * @brief 验证链表一致性
+     * @brief 验证链表与单元格状态一致
      * @param disk 磁盘指针
-     * @return 一致性检查结果
+     * @return 违例数，0表示通过
      */
     int _verify_free_list_consistency(Disk* disk);
     
     /**
-     * @brief 验证链表完整性
-     * @return 完整性检查结果
+     * @brief 验证链表结构与大小索引、free_cells一致
+     * @return 违例数，0表示通过
      */
     int _verify_free_list_integrity();
 
@@ -302,15 +455,92 @@ private:
     
     /**
      * @brief 移除空闲块
-     * @param block 空闲块指针
+     * @param block 空闲块索引
      */
-    void _remove_free_block(FreeBlock* block);
+    void _remove_free_block(int block);
     
     /**
      * @brief 合并相邻空闲块
-     * @param block 空闲块指针
+     * @param block 空闲块索引
+     */
+    void _merge_adjacent_blocks(int block);
+
+    /**
+     * @brief 从空闲块一侧截取单元
+     * @param idx 空闲块索引
+     * @param count 截取数量
+     * @param from_end 是否从高地址侧截取
+     * @param positions 截取到的单元位置(按截取顺序追加)
+     */
+    void _take_from_block(int idx, int count, bool from_end, std::vector<int>& positions);
+
+    /**
+     * @brief 将空闲块加入大小索引
+     * @param idx 空闲块索引
+     */
+    void _index_block(int idx)
+    {
+        int length = block(idx).end - block(idx).start + 1;
+        size_index[{length, block(idx).start}] = idx;
+        start_index[_fit_bucket(length)].insert({block(idx).start, idx});
+    }
+
+    /**
+     * @brief 将空闲块移出大小索引
+     * @param idx 空闲块索引
      */
-    void _merge_adjacent_blocks(FreeBlock* block);
+    void _unindex_block(int idx)
+    {
+        int length = block(idx).end - block(idx).start + 1;
+        size_index.erase({length, block(idx).start});
+        start_index[_fit_bucket(length)].erase({block(idx).start, idx});
+    }
+
+    /**
+     * @brief 空闲块长度所在的首个匹配桶
+     */
+    static int _fit_bucket(int length)
+    {
+        return std::min(length, FIT_BUCKETS) - 1;
+    }
+
+    /**
+     * @brief 清空大小索引与首个匹配索引
+     */
+    void _clear_block_index()
+    {
+        size_index.clear();
+        for (auto &bucket : start_index) bucket.clear();
+    }
+
+    /**
+     * @brief 沿方向查找首个可容纳的空闲块
+     * @param size 单元数(不超过FIT_BUCKETS)
+     * @param is_reverse 是否从高地址向低地址查找
+     * @return 空闲块索引，无可容纳块时为FreeBlock::NIL
+     * @details 长度不小于size的各桶取方向上最靠前的块再比较，O(FIT_BUCKETS × log 空闲块数)
+     */
+    int _find_first_block(int size, bool is_reverse) const;
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ GC候选定义 ═══════════════════════════════╗*/
+/**
+ * @brief     GC候选操作
+ * @details   在当前布局上试运行某一阶段得到的一组交换:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 同一(阶段, 分区)在不同K预算下的结果属于同一组，至多选其一          │
+ * │ 2. 收益为涉及分区的预计读取代价下降量                                 │
+ * │ 3. 涉及分区未被写入、删除或改变范围时，交换对在之后的时间片仍然有效    │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+struct GcCandidate
+{
+    int group;                                // 候选组
+    Part* owner;                              // 试运行所针对的分区
+    std::vector<std::pair<int, int>> pairs;   // 交换对
+    std::vector<Part*> parts;                 // 涉及的分区
+    double gain;                              // 预计读取收益
 };
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
@@ -335,6 +565,8 @@ public:
 
     std::vector<Cell> cells;                      // 磁盘单元格
     std::vector<std::vector<Part>> part_tables;   // 磁盘分区表
+    FreeBlockPool block_pool;                     // 空闲块节点池
+    SubsetMatcher gc_matchers[2];                 // GC子集匹配器(复用)
 
     int K;                            // GC操作令牌
     
@@ -353,10 +585,22 @@ public:
     // 标签间接反向映射，用于交错写入
     int tag_reverse[MAX_TAG_NUM+1] = {0};
 
-    // 请求等待时间统计
-    std::deque<int> recent_wait_times;    // 最近请求等待时间
-    long long total_wait_time = 0;        // 总等待时间
-    static const int MAX_RECENT_REQS = 66;// 记录范围
+    // GC预规划，在GC前的时间片中生成，GC时只校验失效部分
+    std::vector<GcCandidate> gc_plan;                             // 预规划候选
+    std::unordered_map<Part*, std::pair<int, int>> gc_plan_ranges;// 规划时各分区范围
+    std::unordered_set<Part*> gc_plan_dirty;                      // 规划后被写入或删除的分区
+    bool gc_plan_ready = false;                                   // 是否存在预规划
+    int gc_plan_k = 0;                                            // 规划时的K
+
+    // 准入控制服务模型
+    PendingBitmap pending_map;                       // 有未完成请求的单元位图
+    int pending_arrivals[3] = {0};                   // 本时间片各区域新增的待读单元数
+    double arrival_rate[3] = {0};                    // 各区域每时间片新增待读单元数(滑动平均)
+    double read_cost1 = ADMIT_READ_COST_INIT;        // 磁头1每读取单元平均令牌
+    double read_cost2 = ADMIT_READ_COST_INIT;        // 磁头2每读取单元平均令牌
+
+    // 请求时延统计
+    LatencyHist wait_hist[3];             // 完成请求的时延直方图(0为整盘，1、2为各磁头)
 
     /**
      * @brief 磁盘构造函数
@@ -410,6 +654,39 @@ public:
      */
     std::vector<std::pair<int, int>> gc();
 
+    /**
+     * @brief 校验磁盘布局一致性
+     * @return 违例数，0表示通过
+     */
+    int verify_layout();
+
+    /**
+     * @brief 将磁盘完整状态写入二进制状态快照
+     * @param out 写入器
+     */
+    void save_state(StateWriter &out) const;
+
+    /**
+     * @brief 从二进制状态快照恢复磁盘完整状态
+     * @param in 读取器
+     * @return 是否读取成功
+     */
+    bool load_state(StateReader &in);
+
+    /**
+     * @brief 在当前布局上预规划GC候选，供之后的GC时间片校验使用
+     */
+    void prepare_gc();
+
+    /**
+     * @brief 标记预规划后被修改的分区
+     * @param part 分区
+     */
+    void mark_gc_dirty(Part* part)
+    {
+        if (gc_plan_ready) gc_plan_dirty.insert(part);
+    }
+
     /**
      * @brief 获取指定标签的分区
      * @param tag 标签
@@ -421,12 +698,75 @@ public:
     }
 
     /**
-     * @brief 获取平均等待时间
-     * @return 平均等待时间
+     * @brief 获取单元所在的磁头区域
+     * @param cell_idx 单元格索引
+     * @return 1、2为磁头区域，0为备份区
+     */
+    int head_region(int cell_idx) const
+    {
+        return cell_idx <= data_size1 ? 1 : cell_idx <= data_size1 + data_size2 ? 2 : 0;
+    }
+
+    /**
+     * @brief 单元由无请求变为有请求时登记
+     * @param cell_idx 单元格索引
+     */
+    void mark_pending(int cell_idx)
+    {
+        pending_map.set(cell_idx);
+        pending_arrivals[head_region(cell_idx)]++;
+    }
+
+    /**
+     * @brief 单元的请求全部完成或移除时注销
+     * @param cell_idx 单元格索引
      */
-    float get_avg_wait_time() const 
-    { 
-        return static_cast<float>(total_wait_time) / recent_wait_times.size(); 
+    void unmark_pending(int cell_idx)
+    {
+        pending_map.clear(cell_idx);
+    }
+
+    /**
+     * @brief 将上一时间片的新增待读单元数计入到达率
+     */
+    void update_arrival_rate()
+    {
+        for (int region = 1; region <= 2; ++region)
+        {
+            arrival_rate[region] += ADMIT_ARRIVAL_RATE * (pending_arrivals[region] - arrival_rate[region]);
+            pending_arrivals[region] = 0;
+        }
+    }
+
+    /**
+     * @brief 预测读完一组单元所需的时间片数
+     * @param units 待读单元格索引(主副本在本盘)
+     * @return 预测时间片数
+     */
+    double predict_finish(const std::vector<int> &units) const;
+
+    /**
+     * @brief 磁头的准入期限
+     * @param cell_idx 对象所在单元格索引
+     * @return 预测完成时间片数的上限
+     * @details 磁头近期完成请求的p99时延超过ADMIT_TAIL_TARGET时，说明预测偏乐观，
+     *          按超出量收紧期限
+     */
+    double admit_limit(int cell_idx) const
+    {
+        int tail = wait_hist[head_region(cell_idx)].percentile(0.99);
+        return ADMIT_DEADLINE - std::max(0, tail - ADMIT_TAIL_TARGET);
+    }
+
+    /**
+     * @brief 输出本轮各范围的请求时延分布
+     * @param round 轮次
+     */
+    void dump_latency(int round) const
+    {
+        wait_hist[0].dump(round, "disk", id);
+        wait_hist[1].dump(round, "head", id, 1);
+        wait_hist[2].dump(round, "head", id, 2);
     }
 
 private:
@@ -453,17 +793,57 @@ private:
     void _read_cell(int cell_idx, std::vector<int>& completed_reqs);
     
     /**
-     * @brief 更新请求等待时间统计
+     * @brief 记录完成请求的时延
      * @param req_id 请求ID
-     * @param current_timestamp 当前时间戳
+     * @param cell_idx 完成请求的单元格索引
      */
-    void _update_wait_time_stats(int req_id, int current_timestamp);
+    void _update_wait_time_stats(int req_id, int cell_idx);
 
     /**
-     * @brief 更新分区内外部对象
+     * @brief 规划并执行收益最高的GC交换
+     * @param gc_pairs 交换对
      */
-    void _update_other_objs();
-    
+    void _plan_gc(std::vector<std::pair<int, int>>& gc_pairs);
+
+    /**
+     * @brief 枚举GC候选(试运行后回滚)
+     * @param candidates 候选列表
+     * @param owners 仅规划这些分区，为空指针时规划全部数据分区
+     */
+    void _collect_gc_candidates(std::vector<GcCandidate>& candidates,
+                                const std::unordered_set<Part*>* owners = nullptr);
+
+    /**
+     * @brief 校验预规划，重新规划失效的分区
+     */
+    void _refresh_gc_plan();
+
+    /**
+     * @brief 丢弃预规划及失效记录
+     */
+    void _drop_gc_plan();
+
+    /**
+     * @brief 在K预算内选择候选(分组背包)
+     * @param candidates 候选列表
+     * @param budget K预算
+     * @return 选中的候选下标
+     */
+    std::vector<int> _select_gc_candidates(const std::vector<GcCandidate>& candidates, int budget);
+
+    /**
+     * @brief 估计分区的读取代价
+     * @param part 分区
+     * @return 读频率加权的扫描跨度与外来单元惩罚之和
+     */
+    double _part_read_cost(Part& part);
+
+    /**
+     * @brief 按逆序撤销交换
+     * @param pairs 交换对
+     */
+    void _rollback_swaps(const std::vector<std::pair<int, int>>& pairs);
+
     /**
      * @brief 磁盘一对多交换
      * @param gc_pairs 交换对
@@ -499,13 +879,80 @@ private:
      * @param is_split_obj 是否分割对象
      */
     void _part_gc_inner(Part& part, std::vector<std::pair<int, int>>& gc_pairs, bool is_split_obj);
-    
+
+    /**
+     * @brief 磁盘分区边界迁移
+     * @param gc_pairs 交换对
+     */
+    void _disk_gc_boundary(std::vector<std::pair<int, int>>& gc_pairs);
+
+    /**
+     * @brief 分区边界迁移(腾空邻居尾部后迁移)
+     * @param part 将满分区
+     * @param gc_pairs 交换对
+     */
+    void _part_gc_boundary(Part& part, std::vector<std::pair<int, int>>& gc_pairs);
+
+    /**
+     * @brief 获取尾部相对的邻居分区
+     * @param part 分区
+     * @return 邻居分区指针，不存在则为nullptr
+     */
+    Part* _get_boundary_donor(Part& part);
+
+    /**
+     * @brief 向邻居分区尾部迁移边界(不搬移数据)
+     * @param part 将满分区
+     * @return 迁移的单元数
+     */
+    int _part_migrate_boundary(Part& part);
+
+    /**
+     * @brief 登记单元格对象为所属分区的外部对象(如适用)
+     * @param cell_idx 单元格索引
+     */
+    void _track_other_obj(int cell_idx);
+
+    /**
+     * @brief 注销单元格对象在所属分区的外部对象登记(如适用)
+     * @param cell_idx 单元格索引
+     */
+    void _untrack_other_obj(int cell_idx);
+
     /**
      * @brief 交换单元格
      * @param cell_idx1 单元格1
      * @param cell_idx2 单元格2
      */
     void _swap_cell(int cell_idx1, int cell_idx2);
+
+    /**
+     * @brief 按热度聚簇各数据分区
+     * @param gc_pairs 交换对
+     * @param budget 本阶段可用的K
+     */
+    void _disk_gc_heat(std::vector<std::pair<int, int>>& gc_pairs, int budget);
+
+    /**
+     * @brief 分区内热对象向磁头进入端聚簇
+     * @param part 分区
+     * @param gc_pairs 交换对
+     * @param budget 剩余可用的K
+     */
+    void _part_gc_heat(Part& part, std::vector<std::pair<int, int>>& gc_pairs, int& budget);
+
+    /**
+     * @brief 压缩备份区，对象整体向压缩端聚拢
+     * @param gc_pairs 交换对
+     */
+    void _disk_gc_backup(std::vector<std::pair<int, int>>& gc_pairs);
+
+    /**
+     * @brief 获取对象在本盘的副本单元
+     * @param obj 对象
+     * @return 副本单元位置列表
+     */
+    std::vector<int>& _local_replica(Object& obj);
     
     /**
      * @brief 查找一对多匹配
@@ -535,17 +982,6 @@ private:
                          std::vector<int>& matched_objs2, 
                          int max_target_size);
     
-    /**
-     * @brief 动态规划求解子集和
-     * @param size_obj_pairs 大小和对象对
-     * @param target_size 目标大小
-     * @param matched_objs 匹配的对象
-     * @return 是否找到解
-     */
-    bool _dp_subset_sum(const std::vector<std::pair<int, int>>& size_obj_pairs, 
-                       int target_size, 
-                       std::vector<int>& matched_objs);
-    
     /**
      * @brief 执行一对多交换
      * @param single_obj_idx 单个对象索引
@@ -592,14 +1028,26 @@ public:
     std::vector<std::pair<int, std::vector<int>>> replicas; // 副本：磁盘ID和单元索引
     std::unordered_set<int> req_ids;                // 请求ID集合
     bool occupied;                                  // 是否被占用
+    double heat;                                    // 读取热度(截至heat_time的衰减计数)
+    int heat_time;                                  // 热度更新时间戳
 
     /**
      * @brief 对象构造函数
      */
-    Object() : id(0), size(0), tag(0), occupied(false)
+    Object() : id(0), size(0), tag(0), occupied(false), heat(0), heat_time(0)
     {
         replicas.resize(REP_NUM, {0, std::vector<int>()});
     }
+
+    /**
+     * @brief 获取对象热度
+     * @param timestamp 当前时间戳
+     * @return 衰减后的读取热度与未完成请求折算热度之和
+     */
+    double get_heat(int timestamp) const
+    {
+        return heat * std::pow(HEAT_DECAY, timestamp - heat_time) + HEAT_PENDING_WEIGHT * req_ids.size();
+    }
 };
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
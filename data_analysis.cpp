@@ -25,6 +25,8 @@
 #include <algorithm>            // ⟪算法函数⟫
 #include <climits>              // ⟪系统限制常量⟫
 #include <numeric>              // ⟪数值算法⟫
+#include <cassert>              // ⟪断言⟫
+#include <cstdio>               // ⟪文件读取⟫
 
 /*╔══════════════════════════════ 全局数据结构 ══════════════════════════════╗*/
 // ◇ 频率数据结构
@@ -56,13 +58,39 @@ int get_freq(int tag, int timestamp, int op_type)
  * │ 返回：按读取频率排序的标签列表                                          │
  * └──────────────────────────────────────────────────────────────────────┘
  */
-std::vector<int> &get_sorted_read_tag(int timestamp)
+const std::vector<int> &get_sorted_read_tag(int timestamp)
 {
     int slice_idx = std::min((timestamp + FRE_PER_SLICING - 1) / FRE_PER_SLICING, 
                             (int)SORTED_READ_TAGS.size() - 1);
     return SORTED_READ_TAGS[slice_idx];
 }
 
+/*╔══════════════════════════════ 频率表加载 ══════════════════════════════╗
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 功能：用外部文件(如workload_gen输出的.fre)替换内置频率表               │
+ * │ 格式：M行删除、M行写入、M行读取，每行⌈T/1800⌉个对象块数                 │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+void load_fre_tables(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    assert(file != nullptr);
+
+    int slices = (T - 1) / FRE_PER_SLICING + 1;
+    for (auto *table : {&DEL_COUNT, &WRITE_COUNT, &READ_COUNT})
+    {
+        table->assign(M, std::vector<int>(slices, 0));
+        for (int tag_id = 0; tag_id < M; ++tag_id)
+            for (int i = 0; i < slices; ++i)
+            {
+                int matched = fscanf(file, "%d", &(*table)[tag_id][i]);
+                assert(matched == 1);
+                (void)matched;
+            }
+    }
+    fclose(file);
+}
+
 /*╔════════════════════════════ 数据分析初始化 ═══════════════════════════════╗
  * ┌──────────────────────────────────────────────────────────────────────┐
  * │ 功能：初始化并处理系统数据分析                                         │
@@ -45,13 +45,22 @@ extern std::vector<std::vector<std::vector<int>>> FRE;
  */
 int get_token(int timestamp);
 
+/**
+ * @brief     获取特定标签在特定时间的操作频率
+ * @param     tag 标签ID
+ * @param     timestamp 时间戳
+ * @param     op_type 操作类型(0删除，1写入，2读取)
+ * @return    int 该时间片内的操作次数
+ */
+int get_freq(int tag, int timestamp, int op_type);
+
 /**
  * @brief     获取排序后的当前时间读频率的tag
  * @param     timestamp 时间戳
- * @return    std::vector<int>& 按读取频率排序的标签列表
+ * @return    const std::vector<int>& 按读取频率排序的标签列表(只读，可并发访问)
  * @details   返回按照读取频率降序排列的标签序列
  */
-std::vector<int>& get_sorted_read_tag(int timestamp);
+const std::vector<int>& get_sorted_read_tag(int timestamp);
 
 /**
  * @brief     获取与指定标签读取频率相似的标签序列
@@ -67,6 +76,13 @@ std::vector<int>& get_sorted_read_tag(int timestamp);
  */
 std::vector<int> get_similar_tag_sequence(int time, int tag, int mode);
 
+/**
+ * @brief     从频率表文件替换内置的DEL_COUNT、WRITE_COUNT、READ_COUNT
+ * @param     path 文件路径，格式为3×M行(删除、写入、读取)，每行⌈T/1800⌉个对象块数
+ * @details   需在读入T、M之后、process_data_analysis之前调用，文件不完整时断言失败
+ */
+void load_fre_tables(const char *path);
+
 /**
  * @brief     处理数据分析
  * @details   执行系统数据的预处理和分析:
@@ -68,12 +68,15 @@ void Disk::free_cell(int cell_id)
 { 
     Part* part = cells[cell_id].part;
 
-    // ◆ 更新空闲块链表（只更新非备份区的分区）
-    if (part->tag != 0) {
-        part->free_block(cell_id);
-    }
+    // ◆ 注销外部对象登记
+    _untrack_other_obj(cell_id);
+
+    // ◆ 更新空闲块链表
+    part->free_block(cell_id);
     part->free_cells++;
+    mark_gc_dirty(part);
     
     // ◆ 清理单元格信息
+    if (not cells[cell_id].req_ids.empty()) unmark_pending(cell_id);
     cells[cell_id].free();
 }
\ No newline at end of file
@@ -14,6 +14,8 @@
  * │ 空间优化         │ 合并小型空闲块，提高空间利用率                             │
  * ├─────────────────┼───────────────────────────────────────────────────────────┤
  * │ 数据迁移         │ 优化数据布局，减少碎片化                                  │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 并行调度         │ 各磁盘GC互不相交，由工作线程并行执行，按磁盘顺序汇总        │
  * └─────────────────┴───────────────────────────────────────────────────────────┘
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━*/
 
@@ -21,6 +23,50 @@
 #include "debug.h"
 #include "data_analysis.h"
 #include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <set>
+#include <atomic>
+#include <thread>
+
+/*╔══════════════════════════════ 并行调度 ═══════════════════════════════╗*/
+/**
+ * @brief     并行执行所有磁盘的垃圾回收
+ * @return    按磁盘编号排列的交换对，下标0不使用
+ * @details   各磁盘GC只读写本盘的单元格、分区和所移动对象在本盘的副本:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 共享数据(FRE、排序标签、对象大小等)在GC期间只读                    │
+ * │ 2. 工作线程从原子计数器领取磁盘，结果写入各自的输出缓冲               │
+ * │ 3. 按磁盘顺序返回，输出与串行执行逐字节一致                           │
+ * │ 4. 线程数取min(硬件并发数, N, GC_MAX_WORKERS)，为1时直接串行          │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+std::vector<std::vector<std::pair<int, int>>> Controller::gc()
+{
+    std::vector<std::vector<std::pair<int, int>>> results(N + 1);
+    int worker_num = std::min({static_cast<int>(std::thread::hardware_concurrency()), N, GC_MAX_WORKERS});
+
+    std::atomic<int> next_disk{1};
+    auto worker = [&]()
+    {
+        for (int i = next_disk++; i <= N; i = next_disk++)
+        {
+            results[i] = DISKS[i].gc();
+        }
+    };
+
+    if (worker_num <= 1)
+    {
+        worker();
+        return results;
+    }
+    std::vector<std::thread> workers;
+    for (int w = 1; w < worker_num; ++w) workers.emplace_back(worker);
+    worker();
+    for (auto &thread : workers) thread.join();
+    return results;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
 
 /*╔══════════════════════════════ 垃圾回收主函数 ═══════════════════════════════╗*/
 /**
@@ -28,20 +74,32 @@
  * @return    std::vector<std::pair<int, int>> 交换操作的单元格对列表
  * @details   按优先级执行以下垃圾回收策略:
  * ┌──────────────────────────────────────────────────────────────────────┐
- * │ 1. 更新各分区中不属于该分区的对象                                       │
- * │ 2. 尝试一对多组合排列交换                                              │
- * │ 3. 尝试引入空闲块一对多组合排列交换                                     │
- * │ 4. 尝试多对多交换                                                     │
- * │ 5. 分区内部聚拢(不分割对象)                                            │
- * │ 6. 分区内部聚拢(分割对象)                                              │
+ * │ 1. 规划：枚举以下各阶段候选，按读取收益在K内选择后执行                  │
+ * │ 2. 热对象向磁头进入端聚簇(最多使用GC_HEAT_RATE比例的K)                 │
+ * │ 3. 尝试一对多组合排列交换                                              │
+ * │ 4. 尝试引入空闲块一对多组合排列交换                                     │
+ * │ 5. 尝试多对多交换                                                     │
+ * │ 6. 将满分区向邻居尾部迁移边界                                          │
+ * │ 7. 分区内部聚拢(不分割对象)                                            │
+ * │ 8. 分区内部聚拢(分割对象)                                              │
+ * │ 9. 备份区对象整体向压缩端聚拢(只用剩余K，不影响读取)                   │
+ * │ 各分区的外部对象集合由写入、删除和交换增量维护，无需在此重新扫描        │
+ * │ 时间预算降级时: DL_LIGHT跳过2，DL_GREEDY再跳过1，DL_MINIMAL只做3、4     │
  * └──────────────────────────────────────────────────────────────────────┘
  */
 std::vector<std::pair<int, int>> Disk::gc() 
 {
     std::vector<std::pair<int, int>> gc_pairs;
+    int k_total = this->K;
+
+    int level = controller->time_budget.level;
 
-    // ◆ 遍历每个分区，找到不属于该分区的对象
-    _update_other_objs();
+    // ◆ 按收益规划交换，剩余K再按原有顺序贪心使用；不规划时丢弃预规划
+    if(this->K > 0 and level < DL_GREEDY) _plan_gc(gc_pairs);
+    else _drop_gc_plan();
+
+    // ◆ 热对象向磁头进入端聚簇，最多使用GC_HEAT_RATE比例的K
+    if(this->K > 0 and level < DL_LIGHT) _disk_gc_heat(gc_pairs, std::ceil(GC_HEAT_RATE * k_total));
 
     // ◆ 如果K有剩余，尝试一对多组合排列交换
     if(this->K > 0) _disk_gc_s2m(gc_pairs, false);
@@ -49,9 +107,15 @@ std::vector<std::pair<int, int>> Disk::gc()
     // ◆ 如果K有剩余，尝试引入空闲块一对多组合排列交换
     if(this->K > 0) _disk_gc_s2m(gc_pairs, true);
 
+    // ◆ 最低降级等级只做一对多交换
+    if(level >= DL_MINIMAL) return gc_pairs;
+
     // ◆ 如果K有剩余，尝试多对多交换
     if(this->K > 0) _disk_gc_m2m(gc_pairs);
 
+    // ◆ 如果K有剩余，腾空将满分区邻居的尾部并迁移边界
+    if(this->K > 0) _disk_gc_boundary(gc_pairs);
+
     // ◆ 获取读取频率排序的tag
     std::vector<int> sorted_tags = get_sorted_read_tag(controller->timestamp+1);
     std::reverse(sorted_tags.begin(), sorted_tags.end());
@@ -74,37 +138,35 @@ std::vector<std::pair<int, int>> Disk::gc()
         }
     }
 
+    // ◆ 如果K有剩余，压缩备份区
+    if(this->K > 0) _disk_gc_backup(gc_pairs);
+
     return gc_pairs;
 }
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
 /*╔══════════════════════════════ 辅助函数实现 ═══════════════════════════════╗*/
 /**
- * @brief     更新各个分区内不属于该分区的对象
- * @details   遍历所有分区，找出并记录每个分区中不属于该分区的对象
+ * @brief     登记单元格对象为所属分区的外部对象
+ * @param     cell_idx 单元格索引
+ * @details   仅数据区(tag 1-17)且对象标签与分区不同时登记，按单元计数
  */
-void Disk::_update_other_objs()
+void Disk::_track_other_obj(int cell_idx)
 {
-    for(int i = 1; i <= 17; i++)
-    {
-        auto &parts = get_parts(i);
-        for(auto &part : parts) 
-        {
-            for(int i = part.start; true; i+= part.start < part.end?1:-1) 
-            {
-                assert(cells[i].part->tag == part.tag);
-                if(cells[i].obj_id != 0 and cells[i].tag != part.tag) 
-                {
-                    // 如果不在part.other_objs中，则加入
-                    if(std::find(part.other_objs.begin(), part.other_objs.end(), cells[i].obj_id) == part.other_objs.end())
-                    {
-                        part.other_objs.push_back(cells[i].obj_id);
-                    }
-                }
-                if(i == part.end) break;
-            }
-        }
-    }
+    const Cell &cell = cells[cell_idx];
+    if(cell.obj_id == 0 or cell.part->tag == 0 or cell.tag == cell.part->tag) return;
+    cell.part->other_objs.add(cell.obj_id);
+}
+
+/**
+ * @brief     注销单元格对象在所属分区的外部对象登记
+ * @param     cell_idx 单元格索引
+ */
+void Disk::_untrack_other_obj(int cell_idx)
+{
+    const Cell &cell = cells[cell_idx];
+    if(cell.obj_id == 0 or cell.part->tag == 0 or cell.tag == cell.part->tag) return;
+    cell.part->other_objs.remove(cell.obj_id);
 }
 
 /**
@@ -112,147 +174,220 @@ void Disk::_update_other_objs()
  * @param     part 待处理的分区
  * @param     gc_pairs 记录交换操作的列表
  * @param     is_split_obj 是否允许分割对象
- * @details   从分区末端向起始端聚拢，优化数据布局
+ * @details   从分区末端向起始端聚拢，单次扫描完成:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 一次扫描建立空洞索引：空洞为连续的空闲或外来单元，按(长度, 偏移)   │
+ * │    和偏移两种顺序维护                                                 │
+ * │ 2. 尾指针从end向start取末端本标签对象的连续单元段，越过的空洞从索引    │
+ * │    尾部截断                                                           │
+ * │ 3. 最佳匹配：长度最小的可容纳空洞，同长度取最靠近start者，整段搬入     │
+ * │    后原地缩短该空洞                                                   │
+ * │ 4. 无可容纳空洞时：不分割模式结束；分割模式从start侧依次填入空洞       │
+ * │ 总复杂度O(n log n)，n为分区长度                                       │
+ * └──────────────────────────────────────────────────────────────────────┘
  */
 void Disk::_part_gc_inner(Part& part, std::vector<std::pair<int, int>>& gc_pairs, bool is_split_obj)
 {
-    // 从end向start聚拢
-    int end = part.end;
-    int start = part.start;
-    bool is_reverse = end < start;
-    if (not is_split_obj or true) {
-        while(end != start) {
-            // 找到末端第一个完整的obj
-            if(cells[end].obj_id == 0 or controller->OBJECTS[cells[end].obj_id].tag != part.tag)
+    int dir = part.end < part.start ? -1 : 1;
+    int length = std::abs(part.end - part.start) + 1;
+    auto cell_at = [&](int off) { return part.start + off * dir; };
+    auto is_own = [&](int off)
+    {
+        const Cell &cell = cells[cell_at(off)];
+        return cell.obj_id != 0 and cell.tag == part.tag;
+    };
+
+    // ◆ 一次扫描建立空洞索引
+    std::map<int, int> holes;                      // 偏移 -> 长度
+    std::set<std::pair<int, int>> holes_by_len;    // (长度, 偏移)
+    auto set_hole = [&](int off, int len)
+    {
+        auto it = holes.find(off);
+        if (it != holes.end())
+        {
+            holes_by_len.erase({it->second, off});
+            holes.erase(it);
+        }
+        if (len <= 0) return;
+        holes[off] = len;
+        holes_by_len.insert({len, off});
+    };
+    for (int off = 0; off < length; )
+    {
+        if (is_own(off)) { ++off; continue; }
+        int hole_start = off;
+        while (off < length and not is_own(off)) ++off;
+        set_hole(hole_start, off - hole_start);
+    }
+
+    // ◆ 尾指针从end向start聚拢
+    int tail = length - 1;
+    while (tail > 0)
+    {
+        if (not is_own(tail))
+        {
+            --tail;
+            continue;
+        }
+
+        // ● 取末端对象的连续单元段
+        int obj_id = cells[cell_at(tail)].obj_id;
+        std::vector<int> run_cells;
+        while (tail > 0 and cells[cell_at(tail)].obj_id == obj_id)
+        {
+            run_cells.push_back(cell_at(tail));
+            --tail;
+        }
+        if (tail == 0) break;
+        int run_size = run_cells.size();
+
+        // ● 截断位于尾指针之外的空洞
+        while (not holes.empty())
+        {
+            auto [off, len] = *holes.rbegin();
+            if (off > tail) set_hole(off, 0);
+            else
             {
-                end += is_reverse ? 1 : -1;
-                continue;
+                if (off + len - 1 > tail) set_hole(off, tail - off + 1);
+                break;
             }
-            else
+        }
+
+        // ● 最佳匹配空洞，整段搬入
+        auto best = holes_by_len.lower_bound({run_size, INT_MIN});
+        if (best != holes_by_len.end())
+        {
+            auto [len, off] = *best;
+            for (int i = 0; i < run_size; ++i)
+            {
+                _swap_cell(run_cells[i], cell_at(off + i));
+                gc_pairs.push_back({run_cells[i], cell_at(off + i)});
+                this->K -= 1;
+                if (this->K == 0) return;
+            }
+            set_hole(off, 0);
+            set_hole(off + run_size, len - run_size);
+        }
+        // ● 无可容纳空洞，按分割模式从start侧依次填入
+        else
+        {
+            if (not is_split_obj) return;
+            for (int i = 0; i < run_size; ++i)
             {
-                assert(cells[end].obj_id != 0 and controller->OBJECTS[cells[end].obj_id].tag == part.tag);
-                int obj_size = controller->OBJECTS[cells[end].obj_id].size;
-                int obj_id = cells[end].obj_id;
+                if (holes.empty()) return;
+                auto [off, len] = *holes.begin();
+                _swap_cell(cell_at(off), run_cells[i]);
+                gc_pairs.push_back({cell_at(off), run_cells[i]});
+                set_hole(off, 0);
+                set_hole(off + 1, len - 1);
+                this->K -= 1;
+                if (this->K == 0) return;
+            }
+        }
 
-                std::vector<int> candidate_cells;
-                while(cells[end].obj_id == obj_id)
-                {
-                    assert(is_reverse ? end <= start : end >= start);
-                    candidate_cells.push_back(end);
-                    if(end != start) end += is_reverse ? 1 : -1;
-                }
-                if(end == start) break;
-                
-                assert(candidate_cells.size() > 0);
+        // 如果K已经用完，则退出
+        if (this->K == 0) return;
+    }
+}
 
-                // 找到start-end中最佳匹配的空闲区或其他对象
-                
-                // 收集start-end中所有空闲块和其它对象块
-                std::vector<std::vector<int>> candidate_blocks;
-                std::vector<std::vector<int>> candidate_blocks_tmp;
-                int i = start;
-                while(true)
-                {
-                    if(controller->OBJECTS[cells[i].obj_id].tag != part.tag)
-                    {
-                        candidate_blocks.push_back({});
-                        while(controller->OBJECTS[cells[i].obj_id].tag != part.tag or cells[i].obj_id == 0)
-                        {
-                            candidate_blocks.back().push_back(i);
-                            if(i == end) break;
-                            i += is_reverse ? -1 : 1;
-                        }
-                        if(i == end) break;
-                    }
-                    else if(cells[i].obj_id == 0)
-                    {
-                        candidate_blocks_tmp.push_back({});
-                        while(cells[i].obj_id == 0 or controller->OBJECTS[cells[i].obj_id].tag != part.tag)
-                        {
-                            candidate_blocks_tmp.back().push_back(i);
-                            if(i == end) break;
-                            i += is_reverse ? -1 : 1;
-                        }
-                        if(i == end) break;
-                    }
-                    else
-                    {
-                        if(i == end) break;
-                        i += is_reverse ? -1 : 1;
-                    }
-                }
-                // 合并candidate_blocks_tmp
-                candidate_blocks.insert(candidate_blocks.end(), candidate_blocks_tmp.begin(), candidate_blocks_tmp.end());
+/**
+ * @brief     对所有将满分区执行边界迁移
+ * @param     gc_pairs 记录交换操作的列表
+ */
+void Disk::_disk_gc_boundary(std::vector<std::pair<int, int>>& gc_pairs)
+{
+    for(int tag = 1; tag <= M; tag++)
+    {
+        for(auto &part : get_parts(tag))
+        {
+            if(this->K > 0) _part_gc_boundary(part, gc_pairs);
+        }
+    }
+}
 
-                // 找到start-end中最佳匹配的空闲区或其他对象
-                int best_diff = 9999;
-                int best_block_idx = -1;
-                for(int i = 0; i < candidate_blocks.size(); i++)
-                {
-                    assert(candidate_blocks[i].size() > 0);
-                    int diff = candidate_blocks[i].size() - candidate_cells.size();
-                    if(diff < best_diff and diff >= 0)
-                    {
-                        best_diff = diff;
-                        best_block_idx = i;
-                    }
-                }
-                if(best_block_idx != - 1)
-                {
-                    for(int i = 0; i < candidate_cells.size(); i++)
-                    {
-                        _swap_cell(candidate_cells[i], candidate_blocks[best_block_idx][i]);
-                        gc_pairs.push_back({candidate_cells[i], candidate_blocks[best_block_idx][i]});
-                        this->K -= 1;
-                        if(this->K == 0) return;
-                    }
-                }
-                // 如果找不到最佳匹配，则按传统方法
-                else
-                {
-                    if(not is_split_obj) return;
-                    // 从start端开始找空闲块
-                    std::reverse(candidate_cells.begin(), candidate_cells.end());
-                    for(int i = start; ; i += is_reverse ? -1 : 1)
-                    {
-                        if(controller->OBJECTS[cells[i].obj_id].tag != part.tag)
-                        {
-                            _swap_cell(i, candidate_cells.back());
-                            gc_pairs.push_back({i, candidate_cells.back()});
-                            candidate_cells.pop_back();
-                            
-                            this->K -= 1;
-                            if(candidate_cells.size() == 0) break;
-                            if(this->K == 0) return;
-                        }
-                        if(i == end) break;
-                    }
-                    for(int i = start; ; i += is_reverse ? -1 : 1)
-                    {
-                        if(candidate_cells.size() == 0) break;
-                        if(cells[i].obj_id == 0)
-                        {
-                            _swap_cell(i, candidate_cells.back());
-                            gc_pairs.push_back({i, candidate_cells.back()});
-                            candidate_cells.pop_back();
-                            
-                            this->K -= 1;
-                            if(candidate_cells.size() == 0) break;
-                            if(this->K == 0) return;
-                        }
-                        if(i == end) break;
-                    }
-                    // 如果还有剩余的cell，则已经没有空闲空间
-                    if(candidate_cells.size() > 0) return;
-                }
-            }
-            // 如果K已经用完，则退出
-            if(this->K == 0) return;
+/**
+ * @brief     腾空邻居分区尾部窗口后迁移边界
+ * @param     part 将满分区
+ * @param     gc_pairs 记录交换操作的列表
+ * @details   先试算：为窗口内每个非本标签对象在邻居靠近start侧找能完整容纳的空闲块，
+ *            确认总交换数不超过K且腾空后边界能覆盖整个窗口，再执行交换，
+ *            任一条件不满足时不做任何交换
+ */
+void Disk::_part_gc_boundary(Part& part, std::vector<std::pair<int, int>>& gc_pairs)
+{
+    // 检查是否将满
+    int capacity = std::abs(part.end - part.start) + 1;
+    if(part.free_cells > std::max(1, static_cast<int>(BOUNDARY_FULL_RATE * capacity))) return;
 
-        }
+    Part* donor = _get_boundary_donor(part);
+    if(donor == nullptr) return;
+
+    int dir = part.start < part.end ? 1 : -1;
+    int max_step = std::max(BOUNDARY_MIN_STEP, static_cast<int>(BOUNDARY_STEP_RATE * capacity));
+    int donor_capacity = std::abs(donor->end - donor->start) + 1;
+    if(donor_capacity <= max_step) return;
+
+    int window_last = part.end + max_step * dir;
+    auto in_window = [&](int pos) { return (pos - part.end) * dir > 0 and (window_last - pos) * dir >= 0; };
+
+    // 试算边界迁移：按_part_migrate_boundary的规则，非本标签对象视为已腾空
+    int moved_free = 0;
+    for(int step = 0; step < max_step; step++)
+    {
+        int pos = part.end + (step + 1) * dir;
+        int is_free = (cells[pos].obj_id == 0 or cells[pos].tag != part.tag) ? 1 : 0;
+        if(donor->free_cells - moved_free - is_free < BOUNDARY_DONOR_RATE * (donor_capacity - step - 1)) return;
+        moved_free += is_free;
     }
-    return;
 
+    // 试算搬移：邻居窗口外的空闲块按start端顺序，已分配部分从块中扣除
+    bool donor_reverse = donor->start > donor->end;
+    int donor_dir = donor_reverse ? -1 : 1;
+    std::vector<std::pair<int, int>> blocks;
+    for(int idx = donor_reverse ? donor->free_list_tail : donor->free_list_head;
+        idx != FreeBlock::NIL; idx = donor_reverse ? donor->block(idx).prev : donor->block(idx).next)
+    {
+        const FreeBlock& block = donor->block(idx);
+        if(in_window(block.start) or in_window(block.end)) continue;
+        blocks.push_back({block.start, block.end});
+    }
+
+    std::vector<int> planned_objs;
+    std::vector<std::pair<int, int>> plan;
+    int cost = 0;
+    for(int pos = part.end + dir; in_window(pos); pos += dir)
+    {
+        int obj_id = cells[pos].obj_id;
+        if(obj_id == 0 or cells[pos].tag == part.tag) continue;
+        if(std::find(planned_objs.begin(), planned_objs.end(), obj_id) != planned_objs.end()) continue;
+        planned_objs.push_back(obj_id);
+
+        std::vector<int> obj_cells = _local_replica(controller->OBJECTS[obj_id]);
+        int size = static_cast<int>(obj_cells.size());
+        cost += size;
+        if(cost > this->K) return;
+
+        // 对象不拆分，没有整块容纳时放弃本次迁移
+        auto fit = std::find_if(blocks.begin(), blocks.end(),
+            [&](const std::pair<int, int>& b) { return b.second - b.first + 1 >= size; });
+        if(fit == blocks.end()) return;
+
+        int first = donor_reverse ? fit->second : fit->first;
+        for(int i = 0; i < size; i++) plan.push_back({obj_cells[i], first + i * donor_dir});
+        if(donor_reverse) fit->second -= size;
+        else fit->first += size;
+    }
+
+    // 执行交换
+    for(auto [from, to] : plan)
+    {
+        _swap_cell(from, to);
+        gc_pairs.push_back({from, to});
+        this->K -= 1;
+    }
+
+    // 迁移边界
+    _part_migrate_boundary(part);
 }
 
 /**
@@ -283,11 +418,12 @@ void Disk::_disk_gc_s2m(std::vector<std::pair<int, int>>& gc_pairs, bool is_add_
  */
 void Disk::_part_gc_s2m(Part &part, std::vector<std::pair<int, int>> &gc_pairs, bool is_add_free)
 {
-    // 存储将要从part.other_objs中删除的对象ID
-    std::vector<int> to_remove;
-    // 遍历分区中的非本分区对象
-    for (auto &other_obj : part.other_objs)
+    // 遍历分区中的非本分区对象(交换会增量修改集合，先取快照)
+    std::vector<int> other_objs = part.other_objs.items();
+    for (auto &other_obj : other_objs)
     {
+        if (!part.other_objs.contains(other_obj))
+            continue;
         assert(part.tag != controller->OBJECTS[other_obj].tag);
         // 获取对象的标签、目标标签和大小
         int this_tag = part.tag;
@@ -328,17 +464,6 @@ void Disk::_part_gc_s2m(Part &part, std::vector<std::pair<int, int>> &gc_pairs,
                 // 执行一对多交换
                 _swap_s2m(other_obj, matched_objs, gc_pairs, padding, &tmp_part);
 
-                // 标记要删除的对象
-                to_remove.push_back(other_obj);
-
-                // 从tmp_part.other_objs中删除已匹配的对象
-                for (auto &matched_obj : matched_objs)
-                {
-                    tmp_part.other_objs.erase(
-                        std::remove(tmp_part.other_objs.begin(), tmp_part.other_objs.end(), matched_obj),
-                        tmp_part.other_objs.end());
-                }
-
                 // 标记已匹配
                 matched = true;
 
@@ -357,14 +482,6 @@ void Disk::_part_gc_s2m(Part &part, std::vector<std::pair<int, int>> &gc_pairs,
         if (matched)
             continue;
     }
-
-    // 从part.other_objs中移除已交换的对象
-    for (auto obj_id : to_remove)
-    {
-        part.other_objs.erase(
-            std::remove(part.other_objs.begin(), part.other_objs.end(), obj_id),
-            part.other_objs.end());
-    }
 }
 
 /**
@@ -431,22 +548,8 @@ void Disk::_part_gc_m2m(Part &part, std::vector<std::pair<int, int>> &gc_pairs)
                 assert(size1 == size2 and size1 <= this->K);
                 // 执行多对多交换
                 _swap_m2m(matched_objs1, matched_objs2, gc_pairs);
-                // 更新K
+                // 更新K(双方other_objs已由_swap_cell维护)
                 this->K -= size1;
-                // 更新part.other_objs
-                for(auto &obj_id : matched_objs1)
-                {
-                    part.other_objs.erase(
-                        std::remove(part.other_objs.begin(), part.other_objs.end(), obj_id),
-                        part.other_objs.end());
-                }
-                // 更新tmp_part.other_objs
-                for(auto &obj_id : matched_objs2)
-                {
-                    tmp_part.other_objs.erase(
-                        std::remove(tmp_part.other_objs.begin(), tmp_part.other_objs.end(), obj_id),
-                        tmp_part.other_objs.end());
-                }
                 
                 if(this->K == 0) return;
 
@@ -484,17 +587,26 @@ void Disk::_swap_cell(int cell_idx1, int cell_idx2) {
         cell1->part->free_block(cell_idx1);
         cell1->part->free_cells++;
     }
+    // 维护外部对象登记(交换前注销)
+    _untrack_other_obj(cell_idx1);
+    _untrack_other_obj(cell_idx2);
+
     // 维护对象
     Object &obj1 = controller->OBJECTS[cell1->obj_id];
     Object &obj2 = controller->OBJECTS[cell2->obj_id];
 
     if(cell1->obj_id != 0) {
-        assert(this->id == obj1.replicas[0].first);
-        obj1.replicas[0].second[cell1->unit_id-1] = cell_idx2;
+        _local_replica(obj1)[cell1->unit_id-1] = cell_idx2;
     }
     if(cell2->obj_id != 0) {
-        assert(this->id == obj2.replicas[0].first);
-        obj2.replicas[0].second[cell2->unit_id-1] = cell_idx1;
+        _local_replica(obj2)[cell2->unit_id-1] = cell_idx1;
+    }
+
+    // 维护待读单元位图
+    if(cell1->req_ids.empty() != cell2->req_ids.empty())
+    {
+        if(cell1->req_ids.empty()) { pending_map.set(cell_idx1); pending_map.clear(cell_idx2); }
+        else { pending_map.set(cell_idx2); pending_map.clear(cell_idx1); }
     }
 
     // 交换单元格
@@ -502,17 +614,21 @@ void Disk::_swap_cell(int cell_idx1, int cell_idx2) {
     std::swap(cells[cell_idx1].unit_id, cells[cell_idx2].unit_id);
     std::swap(cells[cell_idx1].req_ids, cells[cell_idx2].req_ids);
     std::swap(cells[cell_idx1].tag, cells[cell_idx2].tag);
+
+    // 维护外部对象登记(交换后登记)
+    _track_other_obj(cell_idx1);
+    _track_other_obj(cell_idx2);
 }
 
 /**
- * @brief     多对多匹配函数
+ * @brief     查找多对多匹配
  * @param     candidate_objs1 第一组候选对象
  * @param     candidate_objs2 第二组候选对象
  * @param     matched_objs1 第一组匹配结果
  * @param     matched_objs2 第二组匹配结果
  * @param     max_target_size 最大目标大小
  * @return    bool 是否找到匹配
- * @details   尽可能找到最大的匹配组合
+ * @details   两组分别求可达和，取交集中不超过max_target_size的最大值作为目标
  */
 bool Disk::_find_m2m_match(const std::vector<int>& candidate_objs1, 
                           const std::vector<int>& candidate_objs2, 
@@ -520,41 +636,26 @@ bool Disk::_find_m2m_match(const std::vector<int>& candidate_objs1,
                           std::vector<int>& matched_objs2,
                           int max_target_size)
 {
-    // 准备两组对象的大小列表
-    std::vector<std::pair<int, int>> size_obj_pairs1; // <size, obj_id>
-    std::vector<std::pair<int, int>> size_obj_pairs2;
-    
-    for(auto obj_id : candidate_objs1) {
-        size_obj_pairs1.push_back({controller->OBJECTS[obj_id].size, obj_id});
-    }
-    for(auto obj_id : candidate_objs2) {
-        size_obj_pairs2.push_back({controller->OBJECTS[obj_id].size, obj_id});
-    }
- 
-    // 计算两组对象的总大小
-    int total_size1 = 0, total_size2 = 0;
-    for(const auto& pair : size_obj_pairs1) total_size1 += pair.first;
-    for(const auto& pair : size_obj_pairs2) total_size2 += pair.first;
-    
-    // 最大可能的目标大小是两组对象总大小的较小值
-    max_target_size = std::min(std::min(total_size1, total_size2), max_target_size);
-    
-    // 从最大可能的目标大小开始向下搜索
-    for(int target_size = max_target_size; target_size > 0; target_size--) {
-        std::vector<int> tmp_matched1, tmp_matched2;
-        int padding1 = 0, padding2 = 0;
-        
-        // 尝试在第一组对象中找到匹配
-        bool found1 = _find_s2m_match(candidate_objs1, target_size, tmp_matched1, padding1);
-        if(!found1) continue;
-        
-        // 尝试在第二组对象中找到匹配
-        bool found2 = _find_s2m_match(candidate_objs2, target_size, tmp_matched2, padding2);
-        if(!found2) continue;
-        
-        // 如果两组对象都找到了匹配，则返回结果
-        matched_objs1 = tmp_matched1;
-        matched_objs2 = tmp_matched2;
+    // 两组对象分别装入匹配器
+    SubsetMatcher &matcher1 = gc_matchers[0];
+    SubsetMatcher &matcher2 = gc_matchers[1];
+    matcher1.reset();
+    matcher2.reset();
+    // 降级后只装入前GC_MATCH_LIGHT_LIMIT个候选，缩小搜索
+    size_t limit = controller->time_budget.level >= DL_LIGHT ? GC_MATCH_LIGHT_LIMIT : SIZE_MAX;
+    for(size_t i = 0; i < candidate_objs1.size() and i < limit; ++i)
+        matcher1.add(controller->OBJECTS[candidate_objs1[i]].size, candidate_objs1[i]);
+    for(size_t i = 0; i < candidate_objs2.size() and i < limit; ++i)
+        matcher2.add(controller->OBJECTS[candidate_objs2[i]].size, candidate_objs2[i]);
+
+    // 可达和求交，从最大目标向下查找
+    SubsetMatcher::Bits common = matcher1.build() & matcher2.build();
+    for(int target_size = std::min(max_target_size, SubsetMatcher::MAX_SUM); target_size > 0; target_size--)
+    {
+        if(!common[target_size]) continue;
+        int free_used1 = 0, free_used2 = 0;
+        matcher1.reconstruct(target_size, matched_objs1, free_used1);
+        matcher2.reconstruct(target_size, matched_objs2, free_used2);
         return true;
     }
     
@@ -567,111 +668,45 @@ bool Disk::_find_m2m_match(const std::vector<int>& candidate_objs1,
  * @param     candidate_objs 候选对象列表
  * @param     target_size 目标大小
  * @param     matched_objs 匹配结果
- * @param     padding 允许的填充大小
+ * @param     padding 允许的填充大小，返回实际使用的填充大小
  * @return    bool 是否找到匹配
+ * @details   优先不使用空闲单元匹配，失败且允许填充时再引入空闲单元
  */
 bool Disk::_find_s2m_match(const std::vector<int>& candidate_objs, 
                           int target_size, 
                           std::vector<int>& matched_objs, 
                           int& padding)
 {
-    // 准备候选对象的大小列表
-    std::vector<std::pair<int, int>> size_obj_pairs; // <size, obj_id>
-    for(auto obj_id : candidate_objs)
+    // 候选对象装入匹配器，降级后只装入前GC_MATCH_LIGHT_LIMIT个
+    SubsetMatcher &matcher = gc_matchers[0];
+    matcher.reset();
+    size_t limit = controller->time_budget.level >= DL_LIGHT ? GC_MATCH_LIGHT_LIMIT : SIZE_MAX;
+    for(size_t i = 0; i < candidate_objs.size() and i < limit; ++i)
     {
-        size_obj_pairs.push_back({controller->OBJECTS[obj_id].size, obj_id});
+        matcher.add(controller->OBJECTS[candidate_objs[i]].size, candidate_objs[i]);
     }
+    if(candidate_objs.empty() and padding == 0) return false;
 
-    // 使用动态规划找到匹配的组合
-    bool found = _dp_subset_sum(size_obj_pairs, target_size, matched_objs);
-
-    if(found)
+    // 不使用空闲单元匹配
+    int free_used = 0;
+    if(matcher.build()[target_size])
     {
         padding = 0;
-        return true;
+        return matcher.reconstruct(target_size, matched_objs, free_used);
     }
-    
-    // 如果没有找到匹配的组合，且允许填充空闲块
-    if(!found && padding > 0) {
-        // 将空闲块抽象为大小为1的特殊对象
-        std::vector<std::pair<int, int>> extended_pairs = size_obj_pairs;
-        for(int i = 0; i < padding; i++) {
-            extended_pairs.push_back({1, -1}); // 使用-1表示空闲块
-        }
-        
-        // 再次尝试匹配
-        found = _dp_subset_sum(extended_pairs, target_size, matched_objs);
-        
-        // 计算实际使用的空闲块数量
-        if(found) {
-            int used_padding = 0;
-            for(auto obj_id : matched_objs) {
-                if(obj_id == -1) used_padding++;
-            }
-            padding = used_padding;
-        }
-        // 删除空闲块
-        matched_objs.erase(std::remove(matched_objs.begin(), matched_objs.end(), -1), matched_objs.end());
-    }
-    
-    return found;
-}
 
-/**
- * @brief     动态规划求解子集和问题
- * @param     size_obj_pairs 对象大小和ID对列表
- * @param     target_size 目标大小
- * @param     matched_objs 匹配结果
- * @return    bool 是否找到解
- */
-bool Disk::_dp_subset_sum(const std::vector<std::pair<int, int>>& size_obj_pairs, 
-                         int target_size, 
-                         std::vector<int>& matched_objs)
-{
-    int n = size_obj_pairs.size();
-    
-    // 如果没有候选对象，返回false
-    if(n == 0) return false;
-    
-    // 创建dp表，dp[i][j]表示前i个对象是否可以组成大小j
-    std::vector<std::vector<bool>> dp(n + 1, std::vector<bool>(target_size + 1, false));
-    
-    // 初始化：空集可以组成大小0
-    for(int i = 0; i <= n; i++)
-        dp[i][0] = true;
-    
-    // 动态规划填表
-    for(int i = 1; i <= n; i++)
-    {
-        for(int j = 1; j <= target_size; j++)
-        {
-            // 不选第i个对象
-            dp[i][j] = dp[i-1][j];
-            
-            // 如果当前对象大小不超过j，可以选择该对象
-            if(size_obj_pairs[i-1].first <= j)
-            {
-                dp[i][j] = dp[i][j] || dp[i-1][j - size_obj_pairs[i-1].first];
-            }
-        }
-    }
-    
-    // 如果无法组成目标大小，返回false
-    if(!dp[n][target_size]) return false;
-    
-    // 回溯找出组成目标大小的对象
-    int j = target_size;
-    for(int i = n; i > 0 && j > 0; i--)
+    // 引入空闲单元再次匹配(空闲单元视为大小为1的特殊对象)
+    if(padding > 0)
     {
-        // 如果选择了第i个对象
-        if(dp[i][j] && !dp[i-1][j])
+        matcher.set_free(padding);
+        if(matcher.build()[target_size])
         {
-            matched_objs.push_back(size_obj_pairs[i-1].second);
-            j -= size_obj_pairs[i-1].first;
+            matcher.reconstruct(target_size, matched_objs, free_used);
+            padding = free_used;
+            return true;
         }
     }
-    
-    return true;
+    return false;
 }
 
 /**
@@ -717,10 +752,11 @@ void Disk::_swap_s2m(int single_obj_idx,
 
     // 查找最匹配的空闲块
     bool is_reverse = target_part->start > target_part->end;
-    FreeBlock* best_block = target_part->_find_best_block(padding, is_reverse, false);
-    if(best_block != nullptr) 
+    int best_block = target_part->_find_best_block(padding, is_reverse, false);
+    if(best_block != FreeBlock::NIL) 
     {
-        int cell_idx = is_reverse ? best_block->end : best_block->start;
+        const FreeBlock& block = target_part->block(best_block);
+        int cell_idx = is_reverse ? block.end : block.start;
         while(padding > 0) 
         {
             multi_obj_cells.push_back(cell_idx);
@@ -789,4 +825,182 @@ void Disk::_swap_m2m(const std::vector<int>& matched_objs1,
         
     }
 }
-/*╚═════════════════════════════════════════════════════════════════════════╝*/
\ No newline at end of file
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 热度聚簇 ═══════════════════════════════╗*/
+/**
+ * @brief     按热度聚簇各数据分区
+ * @param     gc_pairs 交换对
+ * @param     budget 本阶段可用的K
+ * @details   读频率高的标签优先，预算用完即停
+ */
+void Disk::_disk_gc_heat(std::vector<std::pair<int, int>>& gc_pairs, int budget)
+{
+    std::vector<int> sorted_tags = get_sorted_read_tag(controller->timestamp+1);
+    std::reverse(sorted_tags.begin(), sorted_tags.end());
+    for(auto &tag : sorted_tags)
+    {
+        for(auto &part : get_parts(tag))
+        {
+            if(budget > 0 and this->K > 0) _part_gc_heat(part, gc_pairs, budget);
+        }
+    }
+}
+
+/**
+ * @brief     分区内热对象向磁头进入端聚簇
+ * @param     part 分区
+ * @param     gc_pairs 交换对
+ * @param     budget 剩余可用的K，按实际交换数扣减
+ * @details   磁头只沿地址递增方向移动，从分区内本标签对象的最低地址进入:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 热度 = 衰减读取计数 + 未完成请求折算，高于分区均值一定量视为热对象  │
+ * │ 2. 只处理本盘副本连续且完全位于分区内的本标签对象                      │
+ * │ 3. 同尺寸对象按地址排序，前缀槽位应全为热对象                          │
+ * │ 4. 前缀之外最热的对象与前缀内地址最低的冷对象整体交换，布局不变        │
+ * │ 5. 未完成请求随单元一起交换，热对象连续读取降低每单元令牌消耗          │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+void Disk::_part_gc_heat(Part& part, std::vector<std::pair<int, int>>& gc_pairs, int& budget)
+{
+    int low = std::min(part.start, part.end);
+    int high = std::max(part.start, part.end);
+    int timestamp = controller->timestamp;
+
+    // ◆ 按地址升序收集候选对象，按尺寸分组
+    std::vector<std::vector<std::pair<int, double>>> groups(6);    // 尺寸 -> (对象ID, 热度)
+    double heat_sum = 0;
+    int obj_count = 0;
+    for (int pos = low; pos <= high; ++pos)
+    {
+        const Cell &cell = cells[pos];
+        if (cell.obj_id == 0 or cell.tag != part.tag) continue;
+        Object &obj = controller->OBJECTS[cell.obj_id];
+        auto &units = _local_replica(obj);
+        auto [min_it, max_it] = std::minmax_element(units.begin(), units.end());
+        if (*min_it != pos) continue;
+        if (*max_it - *min_it + 1 != obj.size or *max_it > high) continue;
+
+        double heat = obj.get_heat(timestamp);
+        groups[obj.size].push_back({obj.id, heat});
+        heat_sum += heat;
+        obj_count++;
+    }
+    if (obj_count == 0) return;
+    double threshold = heat_sum / obj_count + GC_HEAT_MIN_GAIN;
+
+    // ◆ 各尺寸组内将前缀外的热对象换入前缀内的冷对象槽位
+    for (int size = 1; size <= 5; ++size)
+    {
+        auto &group = groups[size];
+        int hot_num = 0;
+        for (auto &[obj_id, heat] : group) hot_num += heat >= threshold;
+
+        std::vector<int> cold_slots;                   // 前缀内冷对象，地址升序
+        std::vector<std::pair<double, int>> misplaced; // 前缀外热对象(热度, 对象ID)
+        for (int i = 0; i < (int)group.size(); ++i)
+        {
+            auto &[obj_id, heat] = group[i];
+            if (i < hot_num and heat < threshold) cold_slots.push_back(obj_id);
+            if (i >= hot_num and heat >= threshold) misplaced.push_back({heat, obj_id});
+        }
+        std::sort(misplaced.rbegin(), misplaced.rend());
+
+        for (int i = 0; i < (int)misplaced.size(); ++i)
+        {
+            if (budget < size or this->K < size) return;
+            std::vector<int> hot_units = _local_replica(controller->OBJECTS[misplaced[i].second]);
+            std::vector<int> cold_units = _local_replica(controller->OBJECTS[cold_slots[i]]);
+            for (int u = 0; u < size; ++u)
+            {
+                _swap_cell(hot_units[u], cold_units[u]);
+                gc_pairs.push_back({hot_units[u], cold_units[u]});
+            }
+            this->K -= size;
+            budget -= size;
+        }
+    }
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 备份区压缩 ═══════════════════════════════╗*/
+/**
+ * @brief     压缩备份区
+ * @param     gc_pairs 交换对
+ * @details   压缩端与备份写入方向一致，从远端向压缩端逐个对象处理:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 对象在本盘的副本单元整体搬入更靠近压缩端、可完整容纳的最佳空闲块    │
+ * │ 2. 搬入后对象单元连续，远端留下整段空闲，写入按大小索引O(log n)分配    │
+ * │ 3. 扫描越过最靠近压缩端的空闲单元后不再有可压缩空间，提前结束          │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+void Disk::_disk_gc_backup(std::vector<std::pair<int, int>>& gc_pairs)
+{
+    for (auto &part : get_parts(0))
+    {
+        bool toward_high = part.start < part.end;
+        int far = toward_high ? std::min(part.start, part.end) : std::max(part.start, part.end);
+        int step = toward_high ? 1 : -1;
+
+        int last_obj = 0;
+        for (int pos = far; this->K > 0; pos += step)
+        {
+            // ◆ 越过最靠近压缩端的空闲单元后结束
+            if (part.free_list_head == FreeBlock::NIL) break;
+            int nearest_free = toward_high ? part.block(part.free_list_tail).end : part.block(part.free_list_head).start;
+            if (toward_high ? pos >= nearest_free : pos <= nearest_free) break;
+
+            int obj_id = cells[pos].obj_id;
+            if (obj_id == 0 or obj_id == last_obj) continue;
+            last_obj = obj_id;
+
+            // ◆ 对象在本盘的副本
+            std::vector<int> units = _local_replica(controller->OBJECTS[obj_id]);
+            int obj_size = units.size();
+            if (obj_size > this->K) continue;
+            int obj_near = toward_high ? *std::max_element(units.begin(), units.end())
+                                       : *std::min_element(units.begin(), units.end());
+
+            // ◆ 查找更靠近压缩端且可完整容纳的最佳空闲块
+            int target = FreeBlock::NIL;
+            for (auto it = part.size_index.lower_bound({obj_size, INT_MIN}); it != part.size_index.end(); ++it)
+            {
+                const FreeBlock &block = part.block(it->second);
+                if (toward_high ? block.start > obj_near : block.end < obj_near)
+                {
+                    target = it->second;
+                    break;
+                }
+            }
+            if (target == FreeBlock::NIL) continue;
+
+            // ◆ 按单元顺序搬入空闲块靠近压缩端的一侧
+            const FreeBlock &block = part.block(target);
+            int head = toward_high ? block.end : block.start;
+            for (int i = 0; i < obj_size; ++i)
+            {
+                int dst = head - i * step;
+                _swap_cell(units[i], dst);
+                gc_pairs.push_back({units[i], dst});
+                this->K -= 1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief     获取对象在本盘的副本单元
+ * @param     obj 对象
+ * @return    副本单元位置列表
+ * @details   对象的三个副本位于不同磁盘，主副本在数据区，其余在备份区
+ */
+std::vector<int>& Disk::_local_replica(Object& obj)
+{
+    for (auto &[disk_id, pos] : obj.replicas)
+    {
+        if (disk_id == this->id) return pos;
+    }
+    assert(false);
+    return obj.replicas[0].second;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
@@ -0,0 +1,186 @@
+/*━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *   ██████╗  ██████╗    ██████╗ ███████╗███╗   ██╗ ██████╗██╗  ██╗
+ *  ██╔════╝ ██╔════╝    ██╔══██╗██╔════╝████╗  ██║██╔════╝██║  ██║
+ *  ██║  ███╗██║         ██████╔╝█████╗  ██╔██╗ ██║██║     ███████║
+ *  ██║   ██║██║         ██╔══██╗██╔══╝  ██║╚██╗██║██║     ██╔══██║
+ *  ╚██████╔╝╚██████╗    ██████╔╝███████╗██║ ╚████║╚██████╗██║  ██║
+ *   ╚═════╝  ╚═════╝    ╚═════╝ ╚══════╝╚═╝  ╚═══╝ ╚═════╝╚═╝  ╚═╝
+ *
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ * 【模块功能】
+ * ┌─────────────────┬───────────────────────────────────────────────────────────┐
+ * │ 快照回放         │ 加载完整状态快照，按给定K执行Disk::gc                      │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 质量指标         │ 输出各分区GC前后的空洞、外来单元、扫描跨度和拆分对象数      │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 一致性校验       │ GC前后校验空闲链表、free_cells与对象副本，失败返回非零      │
+ * └─────────────────┴───────────────────────────────────────────────────────────┘
+ *
+ * 【用法】
+ *   gc_bench [--k K] <快照文件>...
+ *   快照由 cmake -DCMAKE_CXX_FLAGS="-DGC_CAPTURE" 编译的code_craft在GC前写入运行
+ *   目录的gc_snap/，或由-DSTATE_CAPTURE=<间隔>编译时按间隔写入state_snap/，
+ *   两者均为save_state的二进制格式；未指定--k时使用快照中的K
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━*/
+
+#include "ctrl_disk_obj_req.h"  // ⟪控制器、磁盘、对象、请求相关⟫
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*╔══════════════════════════════ 分区指标 ═══════════════════════════════╗*/
+/**
+ * @brief     分区布局指标
+ */
+struct PartMetrics
+{
+    int holes = 0;          // 空闲块数
+    int max_hole = 0;       // 最大空闲块长度
+    int strays = 0;         // 外来对象单元数
+    int span = 0;           // start到最远本标签单元的距离
+    int own = 0;            // 本标签单元数
+    int split_objs = 0;     // 本分区内本盘副本不连续的对象数
+};
+
+/**
+ * @brief     统计分区布局指标
+ * @param     disk 磁盘
+ * @param     part 分区
+ * @return    指标
+ */
+PartMetrics measure_part(Disk &disk, Part &part)
+{
+    PartMetrics metrics;
+    for (int idx = part.free_list_head; idx != FreeBlock::NIL; idx = part.block(idx).next)
+    {
+        metrics.holes++;
+        metrics.max_hole = std::max(metrics.max_hole, part.block(idx).end - part.block(idx).start + 1);
+    }
+
+    int dir = part.start < part.end ? 1 : -1;
+    std::vector<int> seen;
+    for (int pos = part.start, offset = 1; ; pos += dir, ++offset)
+    {
+        const Cell &cell = disk.cells[pos];
+        if (cell.obj_id != 0)
+        {
+            if (part.tag == 0 or cell.tag == part.tag)
+            {
+                metrics.own++;
+                metrics.span = offset;
+            }
+            else metrics.strays++;
+
+            // ● 以单元1为代表检查对象在本盘的副本是否连续
+            if (cell.unit_id == 1)
+            {
+                for (auto &[disk_id, units] : disk.controller->OBJECTS[cell.obj_id].replicas)
+                {
+                    if (disk_id != disk.id) continue;
+                    for (size_t u = 1; u < units.size(); ++u)
+                    {
+                        if (std::abs(units[u] - units[u - 1]) != 1) { metrics.split_objs++; break; }
+                    }
+                }
+            }
+        }
+        if (pos == part.end) break;
+    }
+    return metrics;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 快照回放 ═══════════════════════════════╗*/
+/**
+ * @brief     回放单个快照
+ * @param     path 快照文件路径
+ * @param     k_override 覆盖的K，小于0时使用快照中的K
+ * @return    校验违例总数，加载失败返回-1
+ */
+int run_snapshot(const std::string &path, int k_override)
+{
+    auto controller = std::make_unique<Controller>();
+    auto load_begin = std::chrono::steady_clock::now();
+    bool loaded = controller->load_state(path);
+    long long load_us = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - load_begin).count();
+    if (not loaded)
+    {
+        printf("snapshot=%s load_failed\n", path.c_str());
+        return -1;
+    }
+    printf("snapshot=%s timestamp=%d N=%d V=%d load_us=%lld\n", path.c_str(), controller->timestamp, N, V, load_us);
+
+    int errors = 0;
+    long long total_us = 0;
+    int total_swaps = 0;
+    for (int i = 1; i <= N; ++i)
+    {
+        Disk &disk = controller->DISKS[i];
+        if (k_override >= 0) disk.K = k_override;
+        int k = disk.K;
+
+        // ◆ GC前指标与校验
+        int errors_before = disk.verify_layout();
+        std::vector<std::pair<Part*, PartMetrics>> before;
+        for (auto &tag_parts : disk.part_tables)
+        {
+            for (auto &part : tag_parts) before.push_back({&part, measure_part(disk, part)});
+        }
+
+        // ◆ 执行GC
+        auto begin = std::chrono::steady_clock::now();
+        auto gc_pairs = disk.gc();
+        long long us = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin).count();
+
+        // ◆ GC后校验
+        int errors_after = disk.verify_layout();
+        errors += errors_before + errors_after;
+        total_us += us;
+        total_swaps += gc_pairs.size();
+        printf("disk=%d K=%d swaps=%d time_us=%lld verify_before=%d verify_after=%d\n",
+               i, k, (int)gc_pairs.size(), us, errors_before, errors_after);
+
+        // ◆ 分区指标(GC前 -> GC后)
+        for (auto &[part, pre] : before)
+        {
+            PartMetrics post = measure_part(disk, *part);
+            printf("  part tag=%d range=%d-%d holes=%d->%d max_hole=%d->%d strays=%d->%d "
+                   "span=%d->%d own=%d split_objs=%d->%d\n",
+                   part->tag, part->start, part->end, pre.holes, post.holes, pre.max_hole, post.max_hole,
+                   pre.strays, post.strays, pre.span, post.span, post.own, pre.split_objs, post.split_objs);
+        }
+    }
+    printf("total swaps=%d time_us=%lld verify_errors=%d\n", total_swaps, total_us, errors);
+    return errors;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 主函数 ══════════════════════════════════╗*/
+int main(int argc, char **argv)
+{
+    int k_override = -1;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--k") == 0 and i + 1 < argc) k_override = std::atoi(argv[++i]);
+        else paths.push_back(argv[i]);
+    }
+    if (paths.empty())
+    {
+        printf("usage: gc_bench [--k K] <snapshot>...\n");
+        return 2;
+    }
+
+    int failed = 0;
+    for (auto &path : paths)
+    {
+        if (run_snapshot(path, k_override) != 0) failed++;
+    }
+    return failed == 0 ? 0 : 1;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
@@ -0,0 +1,364 @@
+/*━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *   ██████╗  ██████╗    ██████╗ ██╗      █████╗ ███╗   ██╗
+ *  ██╔════╝ ██╔════╝    ██╔══██╗██║     ██╔══██╗████╗  ██║
+ *  ██║  ███╗██║         ██████╔╝██║     ███████║██╔██╗ ██║
+ *  ██║   ██║██║         ██╔═══╝ ██║     ██╔══██║██║╚██╗██║
+ *  ╚██████╔╝╚██████╗    ██║     ███████╗██║  ██║██║ ╚████║
+ *   ╚═════╝  ╚═════╝    ╚═╝     ╚══════╝╚═╝  ╚═╝╚═╝  ╚═══╝
+ *
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ * 【模块功能】
+ * ┌─────────────────┬───────────────────────────────────────────────────────────┐
+ * │ 候选枚举         │ 在当前布局上试运行各GC阶段，记录交换后回滚                   │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 预规划           │ GC前的时间片中逐盘生成候选，GC时只重新规划失效的分区         │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 收益评估         │ 以下一时间片读频率加权的扫描跨度和外来单元估计读取代价        │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 预算选择         │ 分组背包在K内选出收益最大的候选组合后统一执行                │
+ * └─────────────────┴───────────────────────────────────────────────────────────┘
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━*/
+
+#include "ctrl_disk_obj_req.h"
+#include "data_analysis.h"
+#include "debug.h"
+#include <algorithm>
+#include <unordered_map>
+
+/*╔══════════════════════════════ GC规划主函数 ═══════════════════════════════╗*/
+/**
+ * @brief     规划并执行收益最高的GC交换
+ * @param     gc_pairs 交换对
+ * @details   执行以下步骤:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 取预规划候选并重新规划失效分区；无预规划时在此完整规划              │
+ * │ 2. 分组背包选择，保证各组涉及的分区互不相交                            │
+ * │ 3. 按记录的交换对执行，剩余K交由原有贪心阶段                           │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+void Disk::_plan_gc(std::vector<std::pair<int, int>>& gc_pairs)
+{
+    if (gc_plan_ready and gc_plan_k == this->K) _refresh_gc_plan();
+    else prepare_gc();
+    std::vector<GcCandidate> candidates = std::move(gc_plan);
+    _drop_gc_plan();
+
+    // ◆ 执行选中的候选
+    for (int idx : _select_gc_candidates(candidates, this->K))
+    {
+        for (auto &[cell_idx1, cell_idx2] : candidates[idx].pairs)
+        {
+            _swap_cell(cell_idx1, cell_idx2);
+            gc_pairs.push_back({cell_idx1, cell_idx2});
+            this->K -= 1;
+        }
+        debug("disk", id, "gc plan group", candidates[idx].group, "swaps", candidates[idx].pairs.size(),
+              "gain", candidates[idx].gain);
+    }
+    assert(this->K >= 0);
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 预规划 ═══════════════════════════════╗*/
+/**
+ * @brief     在当前布局上预规划GC候选
+ * @details   由GC前的时间片逐盘调用，把枚举开销从GC时间片分摊出去。
+ *            记录各分区范围，此后的写入和删除通过mark_gc_dirty登记。
+ */
+void Disk::prepare_gc()
+{
+    gc_plan.clear();
+    gc_plan_dirty.clear();
+    gc_plan_ranges.clear();
+    _collect_gc_candidates(gc_plan);
+    for (int tag = 1; tag <= 17; ++tag)
+    {
+        for (auto &part : get_parts(tag)) gc_plan_ranges[&part] = {part.start, part.end};
+    }
+    gc_plan_k = this->K;
+    gc_plan_ready = true;
+}
+
+/**
+ * @brief     丢弃预规划
+ * @details   本次GC不执行收益规划时也须调用：此后的贪心交换不登记失效分区，
+ *            保留的旧规划会在降级恢复后按过时布局执行
+ */
+void Disk::_drop_gc_plan()
+{
+    gc_plan.clear();
+    gc_plan_ranges.clear();
+    gc_plan_dirty.clear();
+    gc_plan_ready = false;
+}
+
+/**
+ * @brief     校验预规划并重新规划失效分区
+ * @details   执行以下步骤:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 失效分区：规划后被写入、删除或范围改变(边界迁移)的分区             │
+ * │ 2. 涉及失效分区的候选作废，其所属分区的全部候选重新试运行             │
+ * │ 3. 其余候选的交换对只涉及未变化的单元，直接保留                       │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+void Disk::_refresh_gc_plan()
+{
+    // ◆ 失效分区
+    std::unordered_set<Part*> stale = gc_plan_dirty;
+    for (auto &[part, range] : gc_plan_ranges)
+    {
+        if (part->start != range.first or part->end != range.second) stale.insert(part);
+    }
+    if (stale.empty()) return;
+
+    // ◆ 需要重新规划的分区
+    std::unordered_set<Part*> owners;
+    for (auto &candidate : gc_plan)
+    {
+        for (Part *part : candidate.parts)
+        {
+            if (stale.count(part)) { owners.insert(candidate.owner); break; }
+        }
+    }
+    for (Part *part : stale)
+    {
+        if (part->tag != 0) owners.insert(part);
+    }
+
+    // ◆ 作废并重新试运行
+    gc_plan.erase(std::remove_if(gc_plan.begin(), gc_plan.end(), [&](const GcCandidate &candidate)
+    {
+        return owners.count(candidate.owner) > 0;
+    }), gc_plan.end());
+    _collect_gc_candidates(gc_plan, &owners);
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 候选枚举 ═══════════════════════════════╗*/
+/**
+ * @brief     枚举GC候选
+ * @param     candidates 候选列表
+ * @param     owners 仅规划这些分区，为空指针时规划全部数据分区
+ * @details   对每个数据分区依次试运行一对多、带空闲一对多、多对多和两种
+ *            分区内聚拢，预算取GC_PLAN_BUDGET_RATES × K；结果记录后立即回滚。
+ *            边界迁移会改变分区范围，不参与规划。
+ */
+void Disk::_collect_gc_candidates(std::vector<GcCandidate>& candidates,
+                                  const std::unordered_set<Part*>* owners)
+{
+    int total_k = this->K;
+    bool light = controller->time_budget.level >= DL_LIGHT;
+
+    // ◆ 基线读取代价(每次试运行后均回滚，基线不变，按需计算)
+    std::unordered_map<Part*, double> base_cost;
+
+    // ◆ 试运行各阶段
+    const int phase_num = 5;
+    int group = 0;
+    for (int tag = 1; tag <= 17; ++tag)
+    {
+        for (auto &part : get_parts(tag))
+        {
+            // ● 组号与是否跳过无关，保证重新规划的候选与保留的候选不冲突
+            if (owners and not owners->count(&part))
+            {
+                group += phase_num;
+                continue;
+            }
+            for (int phase = 0; phase < phase_num; ++phase, ++group)
+            {
+                int prev_size = -1;
+                for (float rate : GC_PLAN_BUDGET_RATES)
+                {
+                    // ● 降级后只试运行满预算
+                    if (light and rate != GC_PLAN_BUDGET_RATES.back()) continue;
+                    int budget = std::max(1, static_cast<int>(rate * total_k));
+                    GcCandidate candidate{group, &part, {}, {}, 0.0};
+
+                    this->K = budget;
+                    switch (phase)
+                    {
+                        case 0: _part_gc_s2m(part, candidate.pairs, false); break;
+                        case 1: _part_gc_s2m(part, candidate.pairs, true); break;
+                        case 2: _part_gc_m2m(part, candidate.pairs); break;
+                        case 3: _part_gc_inner(part, candidate.pairs, false); break;
+                        case 4: _part_gc_inner(part, candidate.pairs, true); break;
+                    }
+
+                    // ● 预算未受限时更大预算结果相同
+                    int size = candidate.pairs.size();
+                    if (size == 0 or size == prev_size)
+                    {
+                        _rollback_swaps(candidate.pairs);
+                        break;
+                    }
+                    prev_size = size;
+
+                    // ● 统计涉及分区与收益
+                    for (auto &[cell_idx1, cell_idx2] : candidate.pairs)
+                    {
+                        for (int cell_idx : {cell_idx1, cell_idx2})
+                        {
+                            Part *touched = cells[cell_idx].part;
+                            if (std::find(candidate.parts.begin(), candidate.parts.end(), touched) == candidate.parts.end())
+                            {
+                                candidate.parts.push_back(touched);
+                            }
+                        }
+                    }
+                    for (Part *touched : candidate.parts)
+                    {
+                        candidate.gain -= _part_read_cost(*touched);
+                    }
+
+                    _rollback_swaps(candidate.pairs);
+                    for (Part *touched : candidate.parts)
+                    {
+                        auto it = base_cost.find(touched);
+                        if (it == base_cost.end()) it = base_cost.emplace(touched, _part_read_cost(*touched)).first;
+                        candidate.gain += it->second;
+                    }
+                    if (candidate.gain > 0) candidates.push_back(std::move(candidate));
+                    if (size < budget) break;
+                }
+            }
+        }
+    }
+    this->K = total_k;
+}
+
+/**
+ * @brief     按逆序撤销交换
+ * @param     pairs 交换对
+ * @details   单元格交换是对合操作，逆序再交换一次即恢复原布局
+ */
+void Disk::_rollback_swaps(const std::vector<std::pair<int, int>>& pairs)
+{
+    for (auto it = pairs.rbegin(); it != pairs.rend(); ++it)
+    {
+        _swap_cell(it->first, it->second);
+    }
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 收益评估 ═══════════════════════════════╗*/
+/**
+ * @brief     估计分区的读取代价
+ * @param     part 分区
+ * @return    读取代价
+ * @details   由两部分组成:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 扫描跨度：从start到最远本标签单元的距离 × 本标签下一时间片读频率    │
+ * │ 2. 外来单元：每个外来单元 × 其标签读频率 × GC_STRAY_PENALTY           │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+double Disk::_part_read_cost(Part& part)
+{
+    if (part.tag == 0) return 0.0;
+    int next_time = controller->timestamp + 1;
+    int dir = part.start < part.end ? 1 : -1;
+
+    double cost = 0.0;
+    int span = 0;
+    for (int i = part.start, offset = 1; ; i += dir, ++offset)
+    {
+        const Cell &cell = cells[i];
+        if (cell.obj_id != 0)
+        {
+            if (cell.tag == part.tag) span = offset;
+            else cost += GC_STRAY_PENALTY * get_freq(cell.tag, next_time, 2);
+        }
+        if (i == part.end) break;
+    }
+    if (part.tag != 17) cost += static_cast<double>(span) * get_freq(part.tag, next_time, 2);
+    return cost;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 预算选择 ═══════════════════════════════╗*/
+/**
+ * @brief     在K预算内选择候选
+ * @param     candidates 候选列表
+ * @param     budget K预算
+ * @return    选中的候选下标
+ * @details   执行以下步骤:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 按组内最佳单位收益降序，贪心保留涉及分区互不相交的组               │
+ * │    (不相交的组互不影响，按记录的交换对执行仍然有效)                   │
+ * │ 2. 分组背包：每组至多选一个预算版本，使总收益最大                     │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+std::vector<int> Disk::_select_gc_candidates(const std::vector<GcCandidate>& candidates, int budget)
+{
+    // ◆ 按组归并
+    std::unordered_map<int, std::vector<int>> group_members;
+    std::vector<int> groups;
+    for (int i = 0; i < static_cast<int>(candidates.size()); ++i)
+    {
+        if (group_members[candidates[i].group].empty()) groups.push_back(candidates[i].group);
+        group_members[candidates[i].group].push_back(i);
+    }
+    auto best_ratio = [&](int group)
+    {
+        double ratio = 0.0;
+        for (int i : group_members[group])
+        {
+            ratio = std::max(ratio, candidates[i].gain / candidates[i].pairs.size());
+        }
+        return ratio;
+    };
+    std::stable_sort(groups.begin(), groups.end(), [&](int a, int b) { return best_ratio(a) > best_ratio(b); });
+
+    // ◆ 保留分区互不相交的组
+    std::vector<Part*> used_parts;
+    std::vector<std::vector<int>> pool;
+    for (int group : groups)
+    {
+        std::vector<Part*> group_parts;
+        for (int i : group_members[group])
+        {
+            group_parts.insert(group_parts.end(), candidates[i].parts.begin(), candidates[i].parts.end());
+        }
+        bool conflict = std::any_of(group_parts.begin(), group_parts.end(), [&](Part *part)
+        {
+            return std::find(used_parts.begin(), used_parts.end(), part) != used_parts.end();
+        });
+        if (conflict) continue;
+        used_parts.insert(used_parts.end(), group_parts.begin(), group_parts.end());
+        pool.push_back(group_members[group]);
+    }
+
+    // ◆ 分组背包 dp[g][c]: 前g组用c次交换的最大收益
+    int group_num = pool.size();
+    std::vector<std::vector<double>> dp(group_num + 1, std::vector<double>(budget + 1, 0.0));
+    std::vector<std::vector<int>> choice(group_num + 1, std::vector<int>(budget + 1, -1));
+    for (int g = 1; g <= group_num; ++g)
+    {
+        for (int c = 0; c <= budget; ++c)
+        {
+            dp[g][c] = dp[g - 1][c];
+            for (int i : pool[g - 1])
+            {
+                int cost = candidates[i].pairs.size();
+                if (cost <= c and dp[g - 1][c - cost] + candidates[i].gain > dp[g][c])
+                {
+                    dp[g][c] = dp[g - 1][c - cost] + candidates[i].gain;
+                    choice[g][c] = i;
+                }
+            }
+        }
+    }
+
+    // ◆ 回溯选择
+    std::vector<int> selected;
+    for (int g = group_num, c = budget; g > 0; --g)
+    {
+        int i = choice[g][c];
+        if (i == -1) continue;
+        selected.push_back(i);
+        c -= candidates[i].pairs.size();
+    }
+    std::reverse(selected.begin(), selected.end());
+    return selected;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
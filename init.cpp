@@ -23,6 +23,8 @@
 #include "debug.h"
 #include "data_analysis.h"
 #include <random>
+#include <algorithm>
+#include <cstdlib>
 
 /*╔══════════════════════════════ 系统初始化函数 ═══════════════════════════════╗*/
 /**
@@ -121,6 +123,7 @@ void Disk::init(int size, const std::vector<int>& tag_order,
     
     // ◆ 分配资源
     cells.resize(size+1);
+    pending_map.reset(size);
     part_tables.resize(M + 2);
  
     // ◆ 计算分区大小
@@ -266,32 +269,143 @@ void Disk::init(int size, const std::vector<int>& tag_order,
     }
     
     // ◆ 初始化空闲块链表
+    // ● 重置节点池，按空闲块数上界(每两个单元至多一个块)预留
+    int part_count = 0;
+    for (auto& tag_parts : part_tables) part_count += tag_parts.size();
+    block_pool.reset(size / 2 + part_count + 1);
+
     // ● 初始化数据区空闲块链表
     for (int tag : tag_order) 
     {
         for (auto& part : get_parts(tag)) 
         {
-            if (part.free_cells > 0) 
-            {
-                part.init_free_list();
-            }
+            part.init_free_list(&block_pool);
         }
     }
     
     // ● 初始化冗余区空闲块链表
     for (auto& part : get_parts(17)) 
     {
-        if (part.free_cells > 0) 
+        part.init_free_list(&block_pool);
+    }
+
+    // ● 初始化备份区空闲块链表
+    for (auto& part : get_parts(0)) 
+    {
+        part.init_free_list(&block_pool);
+    }
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 分区边界迁移 ═══════════════════════════════╗*/
+/**
+ * @brief     获取与分区尾部相对的邻居分区
+ * @param     part 分区
+ * @return    邻居分区指针，不存在则返回nullptr
+ * @details   间歇反向布局下，tag_reverse配对的相邻分区尾部(end)相对:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 本分区end的下一个单元必须是邻居分区的end                            │
+ * │ 2. 邻居分区写入方向与本分区相反                                        │
+ * │ 3. 边界移动不改变相邻关系，tag_reverse保持有效                         │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+Part* Disk::_get_boundary_donor(Part& part)
+{
+    if (part.start == part.end) return nullptr;
+    int dir = part.start < part.end ? 1 : -1;
+    int pos = part.end + dir;
+    if (pos < 1 or pos > size) return nullptr;
+
+    Part* donor = cells[pos].part;
+    if (donor == nullptr or donor == &part or donor->tag == 0) return nullptr;
+    if (donor->end != pos or (donor->start - donor->end) * dir <= 0) return nullptr;
+    return donor;
+}
+
+/**
+ * @brief     向邻居分区尾部迁移边界
+ * @param     part 将满分区
+ * @return    int 迁移的单元数
+ * @details   仅迁移空闲单元和本标签溢出对象，不搬移数据:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 本分区空闲率低于BOUNDARY_FULL_RATE时触发                            │
+ * │ 2. 从边界起向邻居内部扫描，遇到其它标签对象即停止                      │
+ * │ 3. 邻居迁移后空闲率不低于BOUNDARY_DONOR_RATE                           │
+ * │ 4. 同步维护单元格分区指针、空闲块链表和外部对象                        │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+int Disk::_part_migrate_boundary(Part& part)
+{
+    // ◆ 检查触发条件
+    if (part.tag == 0 or part.tag == 17) return 0;
+    int capacity = std::abs(part.end - part.start) + 1;
+    if (part.free_cells > std::max(1, static_cast<int>(BOUNDARY_FULL_RATE * capacity))) return 0;
+
+    Part* donor = _get_boundary_donor(part);
+    if (donor == nullptr) return 0;
+
+    // ◆ 计算可迁移的单元数
+    int dir = part.start < part.end ? 1 : -1;
+    int donor_capacity = std::abs(donor->end - donor->start) + 1;
+    int max_step = std::max(BOUNDARY_MIN_STEP, static_cast<int>(BOUNDARY_STEP_RATE * capacity));
+    int step = 0;
+    int moved_free = 0;
+    for (int pos = part.end + dir; step < max_step and pos != donor->start; pos += dir)
+    {
+        // ● 遇到其它标签对象停止
+        if (cells[pos].obj_id != 0 and cells[pos].tag != part.tag) break;
+
+        // ● 邻居需保留足够空闲
+        int is_free = cells[pos].obj_id == 0 ? 1 : 0;
+        if (donor->free_cells - moved_free - is_free < BOUNDARY_DONOR_RATE * (donor_capacity - step - 1)) break;
+
+        moved_free += is_free;
+        step++;
+    }
+    if (step == 0) return 0;
+
+    // ◆ 从邻居空闲块链表中移除
+    for (int i = 1; i <= step; ++i)
+    {
+        int pos = part.end + i * dir;
+        if (cells[pos].obj_id == 0)
         {
-            part.init_free_list();
+            donor->allocate_block(pos);
+            donor->free_cells--;
         }
     }
+
+    // ◆ 移动边界
+    int old_end = part.end;
+    part.end += step * dir;
+    donor->end += step * dir;
+
+    // ◆ 更新单元格归属、本分区空闲块链表和邻居外部对象
+    for (int i = 1; i <= step; ++i)
+    {
+        int pos = old_end + i * dir;
+        cells[pos].part = &part;
+        if (cells[pos].obj_id == 0)
+        {
+            part.free_block(pos);
+            part.free_cells++;
+        }
+        else
+        {
+            // ● 本标签单元在邻居中属于外部对象，迁入后不再是
+            donor->other_objs.remove(cells[pos].obj_id);
+        }
+    }
+
+    debug("disk", id, "tag", part.tag, "boundary +", step, "from tag", donor->tag);
+    return step;
 }
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
 /*╔══════════════════════════════ 资源清理函数 ═══════════════════════════════╗*/
 /**
- * @brief     磁盘析构函数，清理所有分区的空闲块链表
+ * @brief     磁盘析构函数，整体释放空闲块节点池
+ * @details   节点均位于磁盘自有的节点池中，无需逐个遍历链表释放
  */
 Disk::~Disk() 
 {
@@ -299,8 +413,10 @@ Disk::~Disk()
     {
         for (auto& part : tag_parts) 
         {
-            part._clear_free_list();
+            part.free_list_head = FreeBlock::NIL;
+            part.free_list_tail = FreeBlock::NIL;
         }
     }
+    block_pool.reset(0);
 }
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
\ No newline at end of file
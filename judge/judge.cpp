@@ -0,0 +1,769 @@
+/*━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *       ██╗██╗   ██╗██████╗  ██████╗ ███████╗
+ *       ██║██║   ██║██╔══██╗██╔════╝ ██╔════╝
+ *       ██║██║   ██║██║  ██║██║  ███╗█████╗
+ *  ██   ██║██║   ██║██║  ██║██║   ██║██╔══╝
+ *  ╚█████╔╝╚██████╔╝██████╔╝╚██████╔╝███████╗
+ *   ╚════╝  ╚═════╝ ╚═════╝  ╚═════╝ ╚══════╝
+ *
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ * 【模块功能】
+ * ┌─────────────────┬───────────────────────────────────────────────────────────┐
+ * │ 数据集解析       │ 读取.in数据集：参数行、T+105个时间片的删除/写入/读取事件、  │
+ * │                 │ GC标记，以及第二轮的增量标签信息                            │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 交互驱动         │ 以子进程启动选手程序，经管道按赛题协议逐事件交互两轮         │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 规则校验         │ 三副本放置、令牌与跳转、读取完成、删除取消、GC交换上限、     │
+ * │                 │ 105时间片繁忙窗口，任一违例即判0分并返回非零                 │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 计分与耗时       │ 按request.md的f(x)、h(x)、g(size)计分，并统计选手在各事件    │
+ * │                 │ 阶段的响应墙钟时间                                          │
+ * └─────────────────┴───────────────────────────────────────────────────────────┘
+ *
+ * 【用法】
+ *   judge <数据集.in> <选手程序> [选手参数...]
+ *   结果以key=value行输出到标准输出，例如
+ *   JUDGE round=1 score=.. done=.. busy=.. busy_penalty=.. aborted=..
+ *   JUDGE phase=read wall_ms=..
+ *   JUDGE total score=.. wall_ms=..
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━*/
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/*╔══════════════════════════════ 规则常量 ═══════════════════════════════╗*/
+const int EXTRA_TIME = 105;        // 主时间片后的附加时间片数，也是读取请求的有效时限
+const int GC_INTERVAL = 1800;      // 垃圾回收间隔
+const int FIRST_READ_TOKEN = 64;   // 首次读取令牌
+const int MIN_READ_TOKEN = 16;     // 连续读取令牌下限
+const int REP_NUM = 3;             // 副本数
+
+enum Phase { PH_TIMESTAMP = 0, PH_DELETE, PH_WRITE, PH_READ, PH_GC, PH_NUM };
+const char *PHASE_NAMES[PH_NUM] = {"timestamp", "delete", "write", "read", "gc"};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 数据集 ═══════════════════════════════╗*/
+/**
+ * @brief     单个时间片的输入事件
+ */
+struct TickEvents
+{
+    std::vector<int> deletes;                       // 删除的对象ID
+    std::vector<std::array<int, 3>> writes;         // 写入的(对象ID, 大小, 标签)
+    std::vector<std::pair<int, int>> reads;         // 读取的(请求ID, 对象ID)
+};
+
+/**
+ * @brief     数据集
+ * @details   格式与code_craft从标准输入读到的第一轮内容一致，其后附第二轮增量信息:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ T M N V G K1 K2                                                      │
+ * │ 每个时间片: TIMESTAMP t / 删除 / 写入 / 读取，t为1800倍数时附        │
+ * │ GARBAGE COLLECTION                                                   │
+ * │ n_incremental，随后n行 obj_id tag；缺省视为0，其后内容忽略            │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+struct Dataset
+{
+    int T = 0, M = 0, N = 0, V = 0, G = 0, k1 = 0, k2 = 0;
+    std::vector<TickEvents> ticks;                  // 下标为时间片，0不用
+    std::vector<std::pair<int, int>> incremental;   // 第二轮增量(对象ID, 标签)
+    int max_obj_id = 0;                             // 最大对象ID
+
+    /**
+     * @brief 加载数据集
+     * @param path 文件路径
+     * @return 是否加载成功
+     */
+    bool load(const char *path)
+    {
+        FILE *file = fopen(path, "rb");
+        if (not file) return false;
+        std::vector<char> data;
+        char chunk[1 << 16];
+        for (size_t n; (n = fread(chunk, 1, sizeof(chunk), file)) > 0; ) data.insert(data.end(), chunk, chunk + n);
+        fclose(file);
+        data.push_back('\0');
+
+        // ◆ 逐个读取整数，跳过TIMESTAMP、GARBAGE COLLECTION等单词
+        const char *cursor = data.data();
+        bool ok = true;
+        auto next_int = [&]() -> int {
+            while (*cursor and not (*cursor >= '0' and *cursor <= '9') and *cursor != '-')
+            {
+                if ((*cursor >= 'A' and *cursor <= 'Z') or (*cursor >= 'a' and *cursor <= 'z'))
+                {
+                    while (*cursor and *cursor != ' ' and *cursor != '\n' and *cursor != '\r') cursor++;
+                    while (*cursor == ' ') cursor++;
+                    while (*cursor >= '0' and *cursor <= '9') cursor++;    // TIMESTAMP后的编号
+                }
+                else cursor++;
+            }
+            if (not *cursor) { ok = false; return 0; }
+            char *end;
+            long value = std::strtol(cursor, &end, 10);
+            cursor = end;
+            return static_cast<int>(value);
+        };
+
+        // ◆ 参数与各时间片事件
+        for (int *param : {&T, &M, &N, &V, &G, &k1, &k2}) *param = next_int();
+        ticks.assign(T + EXTRA_TIME + 1, TickEvents());
+        for (int t = 1; t <= T + EXTRA_TIME and ok; ++t)
+        {
+            TickEvents &events = ticks[t];
+            events.deletes.resize(std::max(0, next_int()));
+            for (int &obj_id : events.deletes) obj_id = next_int();
+            events.writes.resize(std::max(0, next_int()));
+            for (auto &write : events.writes)
+            {
+                for (int &value : write) value = next_int();
+                max_obj_id = std::max(max_obj_id, write[0]);
+            }
+            events.reads.resize(std::max(0, next_int()));
+            for (auto &[req_id, obj_id] : events.reads) req_id = next_int(), obj_id = next_int();
+        }
+        if (not ok) return false;
+
+        // ◆ 第二轮增量信息(可缺省)
+        int n_incremental = next_int();
+        for (int i = 0; i < n_incremental and ok; ++i)
+        {
+            int obj_id = next_int(), tag = next_int();
+            if (ok) incremental.push_back({obj_id, tag});
+        }
+        return true;
+    }
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 选手进程 ═══════════════════════════════╗*/
+/**
+ * @brief     选手子进程及双向管道
+ * @details   每个事件整体写入并刷新后再读取响应，与选手"读完事件再输出"的顺序一致
+ */
+class Player
+{
+public:
+    pid_t pid = -1;
+    FILE *to = nullptr;      // 写往选手标准输入
+    FILE *from = nullptr;    // 读取选手标准输出
+    std::string line;        // 最近读取的一行
+
+    /**
+     * @brief 启动选手程序
+     * @param argv 以nullptr结尾的参数表
+     * @return 是否启动成功
+     */
+    bool start(char **argv)
+    {
+        int in_pipe[2], out_pipe[2];
+        if (pipe(in_pipe) != 0 or pipe(out_pipe) != 0) return false;
+        pid = fork();
+        if (pid < 0) return false;
+        if (pid == 0)
+        {
+            dup2(in_pipe[0], STDIN_FILENO);
+            dup2(out_pipe[1], STDOUT_FILENO);
+            close(in_pipe[0]); close(in_pipe[1]);
+            close(out_pipe[0]); close(out_pipe[1]);
+            execvp(argv[0], argv);
+            _exit(127);
+        }
+        close(in_pipe[0]);
+        close(out_pipe[1]);
+        to = fdopen(in_pipe[1], "w");
+        from = fdopen(out_pipe[0], "r");
+        return to and from;
+    }
+
+    /**
+     * @brief 发送一段输入并刷新
+     */
+    void send(const std::string &text)
+    {
+        fwrite(text.data(), 1, text.size(), to);
+        fflush(to);
+    }
+
+    /**
+     * @brief 读取一行(去掉行尾换行)
+     * @return 选手输出结束时返回false
+     */
+    bool read_line()
+    {
+        line.clear();
+        for (int ch; (ch = fgetc(from)) != EOF; )
+        {
+            if (ch == '\n') return true;
+            if (ch != '\r') line.push_back(static_cast<char>(ch));
+        }
+        return not line.empty();
+    }
+
+    /**
+     * @brief 结束选手进程
+     * @details 关闭管道后先等待至多1秒让选手自行退出(以便输出结束时的统计行)，仍未退出再终止
+     */
+    void stop()
+    {
+        if (to) fclose(to), to = nullptr;
+        if (from) fclose(from), from = nullptr;
+        if (pid > 0)
+        {
+            bool exited = false;
+            for (int i = 0; i < 1000 and not exited; ++i)
+            {
+                exited = waitpid(pid, nullptr, WNOHANG) != 0;
+                if (not exited) usleep(1000);
+            }
+            if (not exited)
+            {
+                kill(pid, SIGTERM);
+                waitpid(pid, nullptr, 0);
+            }
+            pid = -1;
+        }
+    }
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 判题状态 ═══════════════════════════════╗*/
+/**
+ * @brief     对象
+ */
+struct JudgeObject
+{
+    int size = 0;                                           // 对象大小，0表示不存在
+    std::array<int, REP_NUM> disks{};                       // 各副本磁盘
+    std::array<std::array<int, 5>, REP_NUM> units{};        // 各副本单元格
+    std::vector<int> req_ids;                               // 未完成的读取请求
+};
+
+/**
+ * @brief     读取请求
+ */
+struct JudgeReq
+{
+    int obj_id;          // 对象ID
+    int timestamp;       // 到达时间片
+    int remain_mask;     // 未读取的对象块位图
+};
+
+/**
+ * @brief     磁头
+ */
+struct JudgeHead
+{
+    int point = 1;            // 当前位置
+    int prev_token = 0;       // 上次读取令牌，0表示上一动作不是读取
+};
+
+/**
+ * @brief     单轮计分
+ */
+struct RoundScore
+{
+    double score = 0;          // 成功读取得分
+    double busy_penalty = 0;   // 繁忙扣分
+    int done = 0;              // 成功读取数
+    int busy = 0;              // 繁忙上报数
+    int aborted = 0;           // 因删除取消数
+};
+
+/**
+ * @brief     判题器
+ * @details   两轮共用同一数据集；第二轮选手从缓存回放输入，判题器只发送TIMESTAMP
+ */
+class Judge
+{
+public:
+    const Dataset &data;
+    Player &player;
+    double phase_ms[PH_NUM] = {0};     // 各阶段等待选手响应的墙钟时间
+    std::string violation;             // 违例描述，非空即判0分
+
+    Judge(const Dataset &data, Player &player) : data(data), player(player) {}
+
+    /**
+     * @brief 执行一轮交互
+     * @param round 轮次(1或2)
+     * @param score 本轮计分
+     * @return 是否无违例
+     */
+    bool run_round(int round, RoundScore &score);
+
+private:
+    int round_ = 1;
+    int t_ = 0;
+    int K_ = 0;
+    std::vector<std::vector<std::pair<int, int>>> cells_;   // [disk][cell] -> (对象ID, 块号)
+    std::vector<JudgeObject> objects_;
+    std::unordered_map<int, JudgeReq> reqs_;
+    std::deque<int> arrivals_;                              // 按到达顺序的请求ID，用于超时检查
+    std::vector<JudgeHead> heads_;                          // 下标 disk*2 + 磁头号(0/1)
+
+    bool _fail(const std::string &reason);
+    bool _expect_line();
+    bool _read_int(int &value);
+    bool _timed(Phase phase, const std::string &input, bool (Judge::*handler)(RoundScore &), RoundScore &score);
+    bool _on_timestamp(RoundScore &score);
+    bool _on_delete(RoundScore &score);
+    bool _on_write(RoundScore &score);
+    bool _on_read(RoundScore &score);
+    bool _on_gc(RoundScore &score);
+    bool _apply_head(int disk_id, JudgeHead &head, const std::string &action);
+    void _finish_req(int req_id);
+};
+
+/**
+ * @brief     记录违例
+ */
+bool Judge::_fail(const std::string &reason)
+{
+    if (violation.empty())
+    {
+        violation = "round=" + std::to_string(round_) + " t=" + std::to_string(t_) + " reason=" + reason;
+    }
+    return false;
+}
+
+/**
+ * @brief     读取选手输出的一行
+ */
+bool Judge::_expect_line()
+{
+    return player.read_line() or _fail("player_output_ended");
+}
+
+/**
+ * @brief     读取选手输出的一个整数行
+ */
+bool Judge::_read_int(int &value)
+{
+    if (not _expect_line()) return false;
+    char *end;
+    value = static_cast<int>(std::strtol(player.line.c_str(), &end, 10));
+    return (end != player.line.c_str() and *end == '\0') or _fail("not_an_integer:" + player.line);
+}
+
+/**
+ * @brief     发送事件输入并计时处理选手响应
+ * @details   计时从输入刷新开始，到响应解析完成为止，归入对应阶段
+ */
+bool Judge::_timed(Phase phase, const std::string &input, bool (Judge::*handler)(RoundScore &), RoundScore &score)
+{
+    auto begin = std::chrono::steady_clock::now();
+    if (not input.empty()) player.send(input);
+    bool ok = (this->*handler)(score);
+    phase_ms[phase] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    return ok;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 一轮交互 ═══════════════════════════════╗*/
+bool Judge::run_round(int round, RoundScore &score)
+{
+    round_ = round;
+    K_ = round == 1 ? data.k1 : data.k2;
+    cells_.assign(data.N + 1, std::vector<std::pair<int, int>>(data.V + 1, {0, 0}));
+    objects_.assign(data.max_obj_id + 1, JudgeObject());
+    reqs_.clear();
+    arrivals_.clear();
+    heads_.assign((data.N + 1) * 2, JudgeHead());
+
+    for (t_ = 1; t_ <= data.T + EXTRA_TIME; ++t_)
+    {
+        const TickEvents &events = data.ticks[t_];
+        bool first = round == 1;
+        std::string input;
+
+        // ◆ 时间片对齐(两轮都发送)
+        if (not _timed(PH_TIMESTAMP, "TIMESTAMP " + std::to_string(t_) + "\n", &Judge::_on_timestamp, score)) return false;
+
+        // ◆ 删除
+        if (first)
+        {
+            input = std::to_string(events.deletes.size()) + "\n";
+            for (int obj_id : events.deletes) input += std::to_string(obj_id) + "\n";
+        }
+        if (not _timed(PH_DELETE, first ? input : "", &Judge::_on_delete, score)) return false;
+
+        // ◆ 写入
+        input.clear();
+        if (first)
+        {
+            input = std::to_string(events.writes.size()) + "\n";
+            for (auto &[obj_id, size, tag] : events.writes)
+            {
+                input += std::to_string(obj_id) + " " + std::to_string(size) + " " + std::to_string(tag) + "\n";
+            }
+        }
+        if (not _timed(PH_WRITE, input, &Judge::_on_write, score)) return false;
+
+        // ◆ 读取(含成功与繁忙上报)
+        input.clear();
+        if (first)
+        {
+            input = std::to_string(events.reads.size()) + "\n";
+            for (auto &[req_id, obj_id] : events.reads)
+            {
+                input += std::to_string(req_id) + " " + std::to_string(obj_id) + "\n";
+            }
+        }
+        if (not _timed(PH_READ, input, &Judge::_on_read, score)) return false;
+
+        // ◆ 超时检查：到达后105个时间片仍未上报即判0分，只需检查最早的未结束请求
+        while (not arrivals_.empty() and reqs_.count(arrivals_.front()) == 0) arrivals_.pop_front();
+        if (not arrivals_.empty() and t_ - reqs_[arrivals_.front()].timestamp >= EXTRA_TIME)
+        {
+            return _fail("request_timeout:" + std::to_string(arrivals_.front()));
+        }
+
+        // ◆ 垃圾回收
+        if (t_ % GC_INTERVAL == 0)
+        {
+            if (not _timed(PH_GC, first ? "GARBAGE COLLECTION\n" : "", &Judge::_on_gc, score)) return false;
+        }
+    }
+    return true;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 事件响应 ═══════════════════════════════╗*/
+/**
+ * @brief     时间片对齐：选手原样输出TIMESTAMP
+ */
+bool Judge::_on_timestamp(RoundScore &)
+{
+    if (not _expect_line()) return false;
+    return player.line == "TIMESTAMP " + std::to_string(t_) or _fail("timestamp_mismatch:" + player.line);
+}
+
+/**
+ * @brief     删除：取消的请求必须恰好是被删对象的全部未完成请求
+ */
+bool Judge::_on_delete(RoundScore &score)
+{
+    std::vector<int> expected;
+    for (int obj_id : data.ticks[t_].deletes)
+    {
+        if (obj_id <= 0 or obj_id >= static_cast<int>(objects_.size()) or objects_[obj_id].size == 0)
+        {
+            return _fail("delete_missing_object:" + std::to_string(obj_id));
+        }
+        JudgeObject &obj = objects_[obj_id];
+        expected.insert(expected.end(), obj.req_ids.begin(), obj.req_ids.end());
+        for (int r = 0; r < REP_NUM; ++r)
+        {
+            for (int u = 0; u < obj.size; ++u) cells_[obj.disks[r]][obj.units[r][u]] = {0, 0};
+        }
+    }
+
+    int n_abort;
+    if (not _read_int(n_abort)) return false;
+    std::vector<int> aborted(std::max(0, n_abort));
+    for (int &req_id : aborted)
+    {
+        if (not _read_int(req_id)) return false;
+    }
+    std::sort(expected.begin(), expected.end());
+    std::sort(aborted.begin(), aborted.end());
+    if (aborted != expected) return _fail("abort_mismatch");
+
+    for (int req_id : aborted) reqs_.erase(req_id);
+    for (int obj_id : data.ticks[t_].deletes) objects_[obj_id] = JudgeObject();
+    score.aborted += aborted.size();
+    return true;
+}
+
+/**
+ * @brief     写入：三副本位于不同磁盘，每个副本的单元格空闲且互不相同
+ */
+bool Judge::_on_write(RoundScore &)
+{
+    for (auto &[obj_id, size, tag] : data.ticks[t_].writes)
+    {
+        int echoed;
+        if (not _read_int(echoed)) return false;
+        if (echoed != obj_id) return _fail("write_id_mismatch:" + std::to_string(echoed));
+
+        JudgeObject &obj = objects_[obj_id];
+        obj.size = size;
+        for (int r = 0; r < REP_NUM; ++r)
+        {
+            if (not _expect_line()) return false;
+            std::vector<int> values;
+            const char *cursor = player.line.c_str();
+            for (char *end; ; cursor = end)
+            {
+                long value = std::strtol(cursor, &end, 10);
+                if (end == cursor) break;
+                values.push_back(static_cast<int>(value));
+            }
+            if (static_cast<int>(values.size()) != size + 1) return _fail("replica_size_mismatch");
+
+            int disk_id = values[0];
+            if (disk_id < 1 or disk_id > data.N) return _fail("replica_bad_disk");
+            for (int q = 0; q < r; ++q)
+            {
+                if (obj.disks[q] == disk_id) return _fail("replicas_share_disk");
+            }
+            obj.disks[r] = disk_id;
+            for (int u = 0; u < size; ++u)
+            {
+                int cell = values[u + 1];
+                if (cell < 1 or cell > data.V) return _fail("replica_bad_cell");
+                if (cells_[disk_id][cell].first != 0) return _fail("write_over_used_cell");
+                cells_[disk_id][cell] = {obj_id, u + 1};
+                obj.units[r][u] = cell;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief     读取：登记新请求，执行2N个磁头动作，校验成功与繁忙上报
+ */
+bool Judge::_on_read(RoundScore &score)
+{
+    // ◆ 登记新请求
+    for (auto &[req_id, obj_id] : data.ticks[t_].reads)
+    {
+        if (obj_id <= 0 or obj_id >= static_cast<int>(objects_.size()) or objects_[obj_id].size == 0)
+        {
+            return _fail("read_missing_object:" + std::to_string(obj_id));
+        }
+        reqs_[req_id] = {obj_id, t_, (1 << objects_[obj_id].size) - 1};
+        objects_[obj_id].req_ids.push_back(req_id);
+        arrivals_.push_back(req_id);
+    }
+
+    // ◆ 磁头动作
+    for (int disk_id = 1; disk_id <= data.N; ++disk_id)
+    {
+        for (int h = 0; h < 2; ++h)
+        {
+            if (not _expect_line()) return false;
+            if (not _apply_head(disk_id, heads_[disk_id * 2 + h], player.line)) return false;
+        }
+    }
+
+    // ◆ 成功上报：每个块至少读过一次
+    int n_rsp;
+    if (not _read_int(n_rsp)) return false;
+    for (int i = 0; i < n_rsp; ++i)
+    {
+        int req_id;
+        if (not _read_int(req_id)) return false;
+        auto it = reqs_.find(req_id);
+        if (it == reqs_.end()) return _fail("unknown_completed_request:" + std::to_string(req_id));
+        if (it->second.remain_mask != 0) return _fail("incomplete_read_reported:" + std::to_string(req_id));
+        int x = t_ - it->second.timestamp;
+        double f = x <= 10 ? -0.005 * x + 1 : x <= EXTRA_TIME ? -0.01 * x + 1.05 : 0;
+        score.score += f * (objects_[it->second.obj_id].size + 1) / 2.0;
+        score.done++;
+        _finish_req(req_id);
+    }
+
+    // ◆ 繁忙上报：按上报时机扣分
+    int n_busy;
+    if (not _read_int(n_busy)) return false;
+    for (int i = 0; i < n_busy; ++i)
+    {
+        int req_id;
+        if (not _read_int(req_id)) return false;
+        auto it = reqs_.find(req_id);
+        if (it == reqs_.end()) return _fail("unknown_busy_request:" + std::to_string(req_id));
+        int x = t_ - it->second.timestamp;
+        score.busy_penalty += static_cast<double>(x) / EXTRA_TIME * (objects_[it->second.obj_id].size + 1) / 2.0;
+        score.busy++;
+        _finish_req(req_id);
+    }
+    return true;
+}
+
+/**
+ * @brief     执行一个磁头的动作串
+ * @details   j X占用整个时间片；否则为p/r序列并以#结尾，累计令牌不得超过G:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ p: 1令牌，前进一格                                                   │
+ * │ r: 上一动作非读取时64令牌，否则max(16, ⌈上次令牌×0.8⌉)，前进一格      │
+ * │ 读取的块从该对象全部未完成请求的剩余位图中移除                        │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+bool Judge::_apply_head(int disk_id, JudgeHead &head, const std::string &action)
+{
+    if (not action.empty() and action[0] == 'j')
+    {
+        int target = std::atoi(action.c_str() + 1);
+        if (target < 1 or target > data.V) return _fail("bad_jump_target");
+        head.point = target;
+        head.prev_token = 0;
+        return true;
+    }
+    if (action.empty() or action.back() != '#') return _fail("head_action_not_terminated");
+
+    int tokens = data.G;
+    for (size_t i = 0; i + 1 < action.size(); ++i)
+    {
+        if (action[i] == 'p')
+        {
+            tokens -= 1;
+            head.prev_token = 0;
+        }
+        else if (action[i] == 'r')
+        {
+            int cost = head.prev_token == 0 ? FIRST_READ_TOKEN
+                                            : std::max(MIN_READ_TOKEN, static_cast<int>(std::ceil(head.prev_token * 0.8)));
+            tokens -= cost;
+            head.prev_token = cost;
+            auto [obj_id, unit_id] = cells_[disk_id][head.point];
+            if (obj_id != 0)
+            {
+                for (int req_id : objects_[obj_id].req_ids) reqs_[req_id].remain_mask &= ~(1 << (unit_id - 1));
+            }
+        }
+        else return _fail("bad_head_action");
+        if (tokens < 0) return _fail("token_overrun");
+        head.point = head.point % data.V + 1;
+    }
+    return true;
+}
+
+/**
+ * @brief     结束一个请求(成功或繁忙)
+ */
+void Judge::_finish_req(int req_id)
+{
+    auto &req_ids = objects_[reqs_[req_id].obj_id].req_ids;
+    req_ids.erase(std::find(req_ids.begin(), req_ids.end(), req_id));
+    reqs_.erase(req_id);
+}
+
+/**
+ * @brief     垃圾回收：每盘至多K次同盘交换，同步更新对象副本位置
+ */
+bool Judge::_on_gc(RoundScore &)
+{
+    if (not _expect_line()) return false;
+    if (player.line != "GARBAGE COLLECTION") return _fail("gc_header_mismatch");
+
+    for (int disk_id = 1; disk_id <= data.N; ++disk_id)
+    {
+        int n_swap;
+        if (not _read_int(n_swap)) return false;
+        if (n_swap < 0 or n_swap > K_) return _fail("gc_over_k");
+        for (int i = 0; i < n_swap; ++i)
+        {
+            int a, b;
+            if (not _expect_line()) return false;
+            if (sscanf(player.line.c_str(), "%d %d", &a, &b) != 2) return _fail("bad_gc_pair");
+            if (a < 1 or a > data.V or b < 1 or b > data.V) return _fail("bad_gc_cell");
+
+            auto &cell_a = cells_[disk_id][a];
+            auto &cell_b = cells_[disk_id][b];
+            std::swap(cell_a, cell_b);
+            for (auto [cell, pos] : {std::make_pair(cell_a, a), std::make_pair(cell_b, b)})
+            {
+                if (cell.first == 0) continue;
+                JudgeObject &obj = objects_[cell.first];
+                for (int r = 0; r < REP_NUM; ++r)
+                {
+                    if (obj.disks[r] == disk_id) obj.units[r][cell.second - 1] = pos;
+                }
+            }
+        }
+    }
+    return true;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 主函数 ══════════════════════════════════╗*/
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        printf("usage: judge <dataset.in> <player> [args...]\n");
+        return 2;
+    }
+
+    Dataset data;
+    if (not data.load(argv[1]))
+    {
+        printf("JUDGE dataset=%s load_failed\n", argv[1]);
+        return 2;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    Player player;
+    if (not player.start(argv + 2))
+    {
+        printf("JUDGE player=%s start_failed\n", argv[2]);
+        return 2;
+    }
+
+    // ◆ 参数
+    auto begin = std::chrono::steady_clock::now();
+    player.send(std::to_string(data.T) + " " + std::to_string(data.M) + " " + std::to_string(data.N) + " " +
+                std::to_string(data.V) + " " + std::to_string(data.G) + " " + std::to_string(data.k1) + " " +
+                std::to_string(data.k2) + "\n");
+    Judge judge(data, player);
+    bool ok = player.read_line() and player.line == "OK";
+    if (not ok) judge.violation = "round=1 t=0 reason=missing_ok";
+
+    // ◆ 两轮交互，轮间发送增量信息
+    RoundScore scores[2];
+    for (int round = 1; round <= 2 and ok; ++round)
+    {
+        ok = judge.run_round(round, scores[round - 1]);
+        if (ok and round == 1)
+        {
+            std::string input = std::to_string(data.incremental.size()) + "\n";
+            for (auto &[obj_id, tag] : data.incremental)
+            {
+                input += std::to_string(obj_id) + " " + std::to_string(tag) + "\n";
+            }
+            player.send(input);
+        }
+    }
+    double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    player.stop();
+
+    // ◆ 输出结果
+    double total = 0;
+    for (int round = 1; round <= 2; ++round)
+    {
+        RoundScore &score = scores[round - 1];
+        printf("JUDGE round=%d score=%.2f done=%d busy=%d busy_penalty=%.2f aborted=%d\n", round,
+               score.score - score.busy_penalty, score.done, score.busy, score.busy_penalty, score.aborted);
+        total += score.score - score.busy_penalty;
+    }
+    for (int phase = 0; phase < PH_NUM; ++phase)
+    {
+        printf("JUDGE phase=%s wall_ms=%.1f\n", PHASE_NAMES[phase], judge.phase_ms[phase]);
+    }
+    if (not ok)
+    {
+        printf("JUDGE violation %s\n", judge.violation.c_str());
+        printf("JUDGE total score=0 wall_ms=%.1f\n", wall_ms);
+        return 1;
+    }
+    printf("JUDGE total score=%.2f wall_ms=%.1f\n", total, wall_ms);
+    return 0;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
@@ -34,6 +34,8 @@
  * ├─────────────────────────┼───────────────────────────────────────────────────┤
  * │ process_busy            │ 处理系统繁忙事件和过载请求                          │
  * ├─────────────────────────┼───────────────────────────────────────────────────┤
+ * │ process_gc_prepare      │ GC前的时间片逐盘预规划垃圾回收                       │
+ * ├─────────────────────────┼───────────────────────────────────────────────────┤
  * │ process_gc              │ 处理垃圾回收事件                                    │
  * └─────────────────────────┴───────────────────────────────────────────────────┘
  * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━*/
@@ -42,6 +44,12 @@
 #include "data_analysis.h"      // ⟪数据分析相关⟫
 #include "ctrl_disk_obj_req.h"  // ⟪控制器、磁盘、对象、请求相关⟫
 #include "debug.h"              // ⟪调试工具⟫
+#include "session.h"            // ⟪交互输入输出⟫
+#include <chrono>
+#if defined(GC_CAPTURE) || defined(STATE_CAPTURE)
+#include <filesystem>
+#endif
+#include <string>
 
 /*╔══════════════════════════════ 函数声明 ═══════════════════════════════╗*/
 void process_data(Controller &controller);                    // ◆ 处理输入信息
@@ -51,12 +59,24 @@ void process_delete(Controller &controller);                  // ◆ 处理删
 void process_write(Controller &controller);                   // ◆ 处理写入事件
 void process_read(Controller &controller);                    // ◆ 处理读取事件
 void process_busy(Controller &controller);                    // ◆ 处理繁忙事件
+void process_gc_prepare(Controller &controller);              // ◆ 预规划垃圾回收
 void process_gc(Controller &controller);                      // ◆ 处理垃圾回收事件
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
 /*╔══════════════════════════════ 主函数 ══════════════════════════════════╗*/
+#ifdef SESSION_REPLAY
+int main(int argc, char **argv)
+{
+    // ▶ 回放构建: replay <轨迹> [--time]，进程内从轨迹读取输入
+    if (argc < 2 or not session_open_replay(argv[1], argc < 3 or std::string(argv[2]) != "--time"))
+    {
+        fprintf(stderr, "usage: replay <trace> [--time]\n");
+        return 2;
+    }
+#else
 int main() 
 {
+#endif
     // ▶ debug 模式下创建 debug 和 info 日志文件
     init_logs();
 
@@ -67,32 +87,69 @@ int main()
     // ▶ 初始化磁盘
     controller.disk_init();
 
-    printf("OK\n");
-    fflush(stdout);
+    session_put_str("OK\n");
+    session_flush();
 
     for (int timestamp = 1; timestamp <= (T + EXTRA_TIME)*2; ++timestamp) 
     {
+        auto tick_begin = std::chrono::steady_clock::now();
+        TimeBudget &budget = controller.time_budget;
+        budget.start_tick();
+
         // ▶ 处理时间戳事件
         process_timestamp(controller, timestamp);
 
         // ▶ 处理删除事件
         process_delete(controller);
+        budget.lap(TP_DELETE);
 
         // ▶ 处理写入事件
         process_write(controller);
+        budget.lap(TP_WRITE);
 
         // ▶ 处理读取事件
         process_read(controller);
+        budget.lap(TP_READ);
 
         // ▶ 处理繁忙事件
         process_busy(controller);
+        budget.lap(TP_BUSY);
+
+        // ▶ GC前的N个时间片逐盘预规划, GC时只校验失效部分; 降级到贪心GC后不再预规划
+        int ticks_to_gc = 1800 - controller.timestamp % 1800;
+        if (ticks_to_gc <= N and budget.level < DL_GREEDY)  process_gc_prepare(controller);
 
         // ▶ 处理垃圾回收事件, 每1800时间片执行一次
         if (controller.timestamp % 1800 == 0)  process_gc(controller);
+        budget.lap(TP_GC);
+
+        // ▶ 按累计耗时调整降级等级
+        budget.end_tick(timestamp <= T + EXTRA_TIME ? 1 : 2, controller.timestamp, T + EXTRA_TIME);
+
+        // ▶ 记录时间片耗时
+        TickKind tick_kind = controller.timestamp % 1800 == 0 ? TK_GC : ticks_to_gc <= N ? TK_GC_PREPARE : TK_NORMAL;
+        controller.tick_stats.record(tick_kind, std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - tick_begin).count());
+
+#ifdef STATE_CAPTURE
+        // ▶ 以-DSTATE_CAPTURE=<间隔>编译时，每隔若干真实时间片保存完整状态快照到state_snap/
+        if (timestamp % STATE_CAPTURE == 0)
+        {
+            int round = timestamp <= T + EXTRA_TIME ? 1 : 2;
+            std::filesystem::create_directories("state_snap");
+            controller.save_state("state_snap/round" + std::to_string(round) + "_t" +
+                                  std::to_string(controller.timestamp) + ".state");
+        }
+#endif
 
         // ▶ 处理第二轮开始的增量信息
         if(timestamp == T + EXTRA_TIME) 
         {
+            // ● 输出第一轮统计
+            controller.write_stats.dump(1);
+            controller.tick_stats.dump(1);
+            controller.dump_latency(1);
+            controller.time_budget.dump(1);
             // ● 更新控制器
             controller = Controller();
             // ● 处理增量信息
@@ -106,8 +163,23 @@ int main()
     info("=============================================================");
     info("busy_count: ", controller.busy_count);
     info("over_load_count: ", controller.over_load_count);
+    controller.write_stats.dump(2);
+    controller.tick_stats.dump(2);
+    controller.dump_latency(2);
+    controller.time_budget.dump(2);
+    for (int i = 1; i <= N; ++i)
+    {
+        info("disk", i, "free block nodes live:", controller.DISKS[i].block_pool.live_count,
+             "peak:", controller.DISKS[i].block_pool.peak_count);
+    }
     info("=============================================================");
     info("OVER");
+
+    // ▶ 写出剩余输出并报告I/O系统调用次数
+    session_finish((T + EXTRA_TIME) * 2);
+#ifdef SESSION_REPLAY
+    return session_close_replay();
+#endif
 }
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
@@ -136,7 +208,7 @@ Type get_input(Controller &controller)
     // ◆ 第一轮交互
     if(controller.timestamp_real <= T + EXTRA_TIME) 
     {
-        scanf("%d", &value);
+        value = session_read_int();
         INPUT.push_back(value);
     } 
     // ◆ 第二轮交互
@@ -161,12 +233,17 @@ Type get_input(Controller &controller)
 void process_data(Controller &controller) 
 {
     // ◆ 读取系统常量参数
-    scanf("%d%d%d%d%d%d%d", &T, &M, &N, &V, &G, &k1, &k2);
+    for (int *param : {&T, &M, &N, &V, &G, &k1, &k2}) *param = session_read_int();
 
     // ◆ 记录参数信息到日志
     info("=============================================================");
     info("T:", T, "M:", M, "N:", N, "V:", V, "G:", G, "k1:", k1, "k2:", k2);
 
+#ifdef FRE_FILE
+    // ◆ 以-DFRE_FILE=\"<路径>\"编译时，用外部频率表(如workload_gen的.fre)替换内置表
+    load_fre_tables(FRE_FILE);
+#endif
+
     // ◆ 预处理数据分析
     process_data_analysis();
 }
@@ -182,14 +259,15 @@ void process_data(Controller &controller)
  */
 void process_incremental_info(Controller &controller, int timestamp) 
 {
-    int n_incremental;
-    scanf("%d", &n_incremental);
+    int n_incremental = session_read_int();
     
     // ◆ 读取每个增量对象信息
     for (int i = 0; i < n_incremental; ++i) 
     {
-        int obj_id, tag;
-        scanf("%d%d", &obj_id, &tag);
+        int obj_id = session_read_int();
+        int tag = session_read_int();
+        (void)obj_id;
+        (void)tag;
     }
 }
 
@@ -206,7 +284,8 @@ void process_incremental_info(Controller &controller, int timestamp)
  */
 void process_timestamp(Controller &controller, int timestamp) 
 {
-    scanf("%*s%*d");
+    session_skip_token();
+    session_skip_token();
     
     // ◆ 重置所有磁盘的令牌数
     for (int i = 1; i <= N; ++i) 
@@ -221,8 +300,10 @@ void process_timestamp(Controller &controller, int timestamp)
     controller.timestamp = (timestamp-1) % (T + EXTRA_TIME) + 1;
     
     // ◆ 输出当前时间戳
-    printf("TIMESTAMP %d\n", (timestamp-1) % (T + EXTRA_TIME) + 1);
-    fflush(stdout);
+    session_put_str("TIMESTAMP ");
+    session_put_int((timestamp-1) % (T + EXTRA_TIME) + 1);
+    session_put_char('\n');
+    session_flush();
 }
 
 /**
@@ -244,8 +325,8 @@ void process_delete(Controller &controller)
     // ◆ 无删除请求时直接返回
     if (n_delete == 0) 
     {
-        printf("0\n");
-        fflush(stdout);
+        session_put_str("0\n");
+        session_flush();
         return;
     }
 
@@ -265,12 +346,14 @@ void process_delete(Controller &controller)
     }
     
     // ◆ 输出被中断的请求
-    printf("%d\n", (int)aborted_requests.size());
+    session_put_int((int)aborted_requests.size());
+    session_put_char('\n');
     for (int req_id : aborted_requests) 
     {
-        printf("%d\n", req_id);
+        session_put_int(req_id);
+        session_put_char('\n');
     }
-    fflush(stdout);
+    session_flush();
 }
 
 /**
@@ -301,18 +384,21 @@ void process_write(Controller &controller)
         Object *obj = controller.write(obj_id, obj_size, tag);
         
         // ● 输出写入结果
-        printf("%d\n", obj_id);
+        session_put_int(obj_id);
+        session_put_char('\n');
         for (const auto &[disk_id, cell_idxs] : obj->replicas) 
         {
-            printf("%d ", disk_id);
+            session_put_int(disk_id);
+            session_put_char(' ');
             for (size_t j = 0; j < cell_idxs.size(); ++j) 
             {
-                printf(" %d", cell_idxs[j]);
+                session_put_char(' ');
+                session_put_int(cell_idxs[j]);
             }
-            printf("\n");
+            session_put_char('\n');
         }
     }
-    fflush(stdout);
+    session_flush();
 }
 
 /**
@@ -352,16 +438,19 @@ void process_read(Controller &controller)
     // ◆ 输出磁头操作
     for (const auto &op : disk_operations) 
     {
-        printf("%s\n", op.c_str());
+        session_put_str(op);
+        session_put_char('\n');
     }
 
     // ◆ 输出完成的请求
-    printf("%d\n", (int)completed_requests.size());
+    session_put_int((int)completed_requests.size());
+    session_put_char('\n');
     for (int req_id : completed_requests) 
     {
-        printf("%d\n", req_id);
+        session_put_int(req_id);
+        session_put_char('\n');
     }
-    fflush(stdout);
+    session_flush();
 }
 
 /**
@@ -381,17 +470,20 @@ void process_busy(Controller &controller)
     int n_busy = controller.busy_reqs.size();            // ● 被动过滤的繁忙请求
 
     // ◆ 输出过滤结果
-    printf("%d\n", n_busy + n_over_load);
+    session_put_int(n_busy + n_over_load);
+    session_put_char('\n');
     
     for (int i = 0; i < n_busy; i++) 
     {
-        printf("%d\n", controller.busy_reqs[i]);
+        session_put_int(controller.busy_reqs[i]);
+        session_put_char('\n');
     }
     for (int i = 0; i < n_over_load; i++) 
     {
-        printf("%d\n", controller.over_load_reqs[i]);
+        session_put_int(controller.over_load_reqs[i]);
+        session_put_char('\n');
     }
-    fflush(stdout);
+    session_flush();
 
     // ◆ 清理并更新统计信息
     controller.over_load_reqs.clear();
@@ -400,33 +492,62 @@ void process_busy(Controller &controller)
     controller.over_load_count += n_over_load;
 }
 
+/**
+ * @brief     预规划垃圾回收
+ * @param     controller 控制器对象
+ * @details   GC前第i个时间片预规划磁盘i，GC时间片只需校验并重新规划失效分区
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 规划结果不产生输出，被写入、删除或迁移边界的分区在GC时重新规划         │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+void process_gc_prepare(Controller &controller) 
+{
+    int disk_id = 1800 - controller.timestamp % 1800;
+    if (controller.DISKS[disk_id].K > 0) controller.DISKS[disk_id].prepare_gc();
+}
+
 /**
  * @brief     处理垃圾回收事件
  * @param     controller 控制器对象
  * @details   对每个磁盘执行垃圾回收操作
  * ┌──────────────────────────────────────────────────────────────────────┐
  * │ 处理垃圾回收事件输入                                                   │
- * │ 对每个磁盘执行垃圾回收并输出结果                                        │
+ * │ 以-DGC_CAPTURE编译时，GC前保存完整状态快照到gc_snap/                   │
+ * │ 各磁盘并行执行垃圾回收，按磁盘顺序输出结果                              │
  * └──────────────────────────────────────────────────────────────────────┘
  */
 void process_gc(Controller &controller) 
 {
     if(controller.timestamp_real <= T + EXTRA_TIME) 
     {
-        (void)scanf("%*s%*s");
+        session_skip_token();
+        session_skip_token();
     }
-    printf("GARBAGE COLLECTION\n");
-
-    // ◆ 对每个磁盘执行垃圾回收
+    session_put_str("GARBAGE COLLECTION\n");
+
+#ifdef GC_CAPTURE
+    // ◆ 保存GC前的完整状态快照，供gc_bench离线复现
+    int round = controller.timestamp_real <= T + EXTRA_TIME ? 1 : 2;
+    std::filesystem::create_directories("gc_snap");
+    controller.save_state("gc_snap/round" + std::to_string(round) + "_t" + 
+                          std::to_string(controller.timestamp) + ".state");
+#endif
+
+    // ◆ 各磁盘并行垃圾回收，按磁盘顺序输出
+    auto disk_gc_pairs = controller.gc();
     for (int i = 1; i <= N; i++) 
     {
-        auto gc_pairs = controller.DISKS[i].gc();
-        printf("%d\n", (int)gc_pairs.size());
+        auto &gc_pairs = disk_gc_pairs[i];
+        session_put_int((int)gc_pairs.size());
+        session_put_char('\n');
         for (auto &pair : gc_pairs) 
         {
-            printf("%d %d\n", pair.first, pair.second);
+            session_put_int(pair.first);
+            session_put_char(' ');
+            session_put_int(pair.second);
+            session_put_char('\n');
         }
     }
-    fflush(stdout);
+    session_flush();
 }
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
\ No newline at end of file
@@ -179,9 +179,11 @@ std::tuple<std::string, std::vector<int>, std::vector<int>> Disk::_read_by_best_
     int &point = op_id == 1 ? point1 : point2;
     int &tokens = op_id == 1 ? tokens1 : tokens2;
     int &prev_read_token = op_id == 1 ? prev_read_token1 : prev_read_token2;
+    double &read_cost = op_id == 1 ? read_cost1 : read_cost2;
     int data_size = op_id == 1 ? data_size1 : data_size2;
     int part_start = op_id == 1 ? 1 : data_size1 + 1;
     int part_end = op_id == 1 ? data_size1 : data_size1 + data_size2;
+    int read_tokens = 0, read_units = 0;
 
     // ◆ 初始化滑动窗口
     int win_end = point;
@@ -217,6 +219,8 @@ std::tuple<std::string, std::vector<int>, std::vector<int>> Disk::_read_by_best_
         {
             path.append(1, 'r');
             _read_cell(point, completed_reqs);
+            read_tokens += decision.cost;
+            read_units++;
         }
         else
         {
@@ -234,6 +238,12 @@ std::tuple<std::string, std::vector<int>, std::vector<int>> Disk::_read_by_best_
         win_end = win_end % size + 1;
     }
 
+    // ◆ 更新每读取单元平均令牌(准入控制服务模型)
+    if (read_units > 0)
+    {
+        read_cost += ADMIT_READ_COST_RATE * (static_cast<double>(read_tokens) / read_units - read_cost);
+    }
+
     return {path, completed_reqs, occupied_obj};
 }
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
@@ -269,7 +279,7 @@ void Disk::_read_cell(int cell_idx, std::vector<int>& completed_reqs)
         if (controller->REQS[req_id % LEN_REQ].remain_units.empty())
         {
             completed_reqs.push_back(req_id);
-            _update_wait_time_stats(req_id, controller->timestamp);
+            _update_wait_time_stats(req_id, cell_idx);
             controller->OBJECTS[cells[cell_idx].obj_id].req_ids.erase(req_id);
             controller->REQS[req_id % LEN_REQ].clear();
         }
@@ -278,36 +288,43 @@ void Disk::_read_cell(int cell_idx, std::vector<int>& completed_reqs)
     // ◆ 清理单元状态
     assert(cells[cell_idx].obj_id != 0);
     cells[cell_idx].req_ids.clear();
+    unmark_pending(cell_idx);
 }
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
 /*╔══════════════════════════════ 性能统计模块 ═══════════════════════════════╗*/
 /**
- * @brief     更新请求等待时间统计数据
+ * @brief     记录完成请求的时延
  * @param     req_id 请求ID
- * @param     current_timestamp 当前时间戳
+ * @param     cell_idx 完成请求的单元格索引
  * @details   执行以下步骤:
  * ┌──────────────────────────────────────────────────────────────────────┐
- * │ 1. 计算请求等待时间                                                   │
- * │ 2. 更新统计数据                                                       │
- * │ 3. 维护最近请求队列                                                   │
+ * │ 1. 计算请求时延(完成时间片 - 创建时间片)                               │
+ * │ 2. 计入整盘和完成单元所在磁头的直方图                                   │
+ * │ 3. 计入对象标签的直方图                                                │
  * └──────────────────────────────────────────────────────────────────────┘
  */
-void Disk::_update_wait_time_stats(int req_id, int current_timestamp)
+void Disk::_update_wait_time_stats(int req_id, int cell_idx)
 {
-    // ◆ 计算等待时间
-    int req_timestamp = controller->REQS[req_id % LEN_REQ].timestamp;
-    int wait_time = current_timestamp - req_timestamp;
-    
-    // ◆ 更新统计数据
-    total_wait_time += wait_time;
-    recent_wait_times.push_back(wait_time);
-    
-    // ◆ 维护最近请求队列
-    if (recent_wait_times.size() > MAX_RECENT_REQS) 
-    {
-        total_wait_time -= recent_wait_times.front();
-        recent_wait_times.pop_front();
-    }
+    // ◆ 计算时延
+    int timestamp = controller->timestamp;
+    int wait_time = timestamp - controller->REQS[req_id % LEN_REQ].timestamp;
+
+    // ◆ 计入磁盘与磁头
+    wait_hist[0].record(wait_time, timestamp);
+    wait_hist[head_region(cell_idx)].record(wait_time, timestamp);
+
+    // ◆ 计入标签
+    controller->tag_wait_hist[controller->OBJECTS[cells[cell_idx].obj_id].tag].record(wait_time, timestamp);
+}
+
+/**
+ * @brief     输出本轮各磁盘、磁头和标签的请求时延分布
+ * @param     round 轮次
+ */
+void Controller::dump_latency(int round) const
+{
+    for (int i = 1; i <= N; ++i) DISKS[i].dump_latency(round);
+    for (int tag = 1; tag <= MAX_TAG_NUM; ++tag) tag_wait_hist[tag].dump(round, "tag", tag);
 }
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
\ No newline at end of file
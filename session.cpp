@@ -0,0 +1,534 @@
+/*━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *  ███████╗███████╗███████╗███████╗██╗ ██████╗ ███╗   ██╗
+ *  ██╔════╝██╔════╝██╔════╝██╔════╝██║██╔═══██╗████╗  ██║
+ *  ███████╗█████╗  ███████╗███████╗██║██║   ██║██╔██╗ ██║
+ *  ╚════██║██╔══╝  ╚════██║╚════██║██║██║   ██║██║╚██╗██║
+ *  ███████║███████╗███████║███████║██║╚██████╔╝██║ ╚████║
+ *  ╚══════╝╚══════╝╚══════╝╚══════╝╚═╝ ╚═════╝ ╚═╝  ╚═══╝
+ *
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ * 【模块功能】
+ * ┌─────────────────┬───────────────────────────────────────────────────────────┐
+ * │ 直通模式         │ 输入经read(2)大块读取并手写解析，输出写入单一缓冲区         │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 录制模式         │ 输入整数与输出字节按刷新分帧，先落盘轨迹再刷新标准输出       │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 回放模式         │ 整个轨迹读入内存，按帧提供输入并比对输出，结束时输出汇总行   │
+ * └─────────────────┴───────────────────────────────────────────────────────────┘
+ *
+ * 【说明】
+ *   1. 只录制从标准输入读到的整数；第二轮由INPUT缓存重放的输入不再录制
+ *   2. 被跳过的记号(TIMESTAMP、GARBAGE COLLECTION)不录制，回放时也不读取
+ *   3. 程序中的随机数均为固定种子，同一版本的回放输出应与录制逐字节一致
+ *   4. 标准输入只经本模块读取，不与scanf混用；read(2)返回已到达的数据即可，
+ *      解析到记号末尾即停止，不会为尚未发送的数据阻塞
+ *   5. 输出只在即将等待输入、缓冲区满或程序结束时一次write(2)写出：判题器
+ *      只有看到输出后才会发送下一段输入，因此等待输入前写出即足够
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━*/
+
+#include "session.h"    // 交互输入输出
+#include "stats.h"      // 统计行输出
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#ifdef SESSION_REPLAY
+#include <chrono>
+#endif
+
+#if defined(SESSION_RECORD) && defined(SESSION_REPLAY)
+#error "SESSION_RECORD and SESSION_REPLAY are mutually exclusive"
+#endif
+
+/*╔══════════════════════════════ 输出缓冲 ═══════════════════════════════╗*/
+/**
+ * @brief     标准输出的缓冲写出器
+ * @details   协议输出全部追加到定长缓冲区，由调用方在协议点调用write_out:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 整数从低位向高位写入临时数组再整段追加，不经printf格式解析         │
+ * │ 2. 缓冲区满时提前写出，超过缓冲区的长串直接写出                       │
+ * │ 3. 统计write(2)调用次数与字节数，程序结束时随IO_STATS输出            │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class OutputWriter
+{
+public:
+    long long write_calls = 0;    // write(2)调用次数
+    long long bytes = 0;          // 写出字节数
+
+    /**
+     * @brief 追加一段字节
+     */
+    void put(const char *text, size_t length)
+    {
+        if (len + length > BUFFER_SIZE)
+        {
+            write_out();
+            if (length > BUFFER_SIZE) return _write_all(text, length);
+        }
+        std::memcpy(buffer + len, text, length);
+        len += length;
+    }
+
+    /**
+     * @brief 追加一个字节
+     */
+    void put_char(char c)
+    {
+        if (len == BUFFER_SIZE) write_out();
+        buffer[len++] = c;
+    }
+
+    /**
+     * @brief 追加一个十进制整数
+     */
+    void put_int(int value)
+    {
+        char digits[12];
+        int pos = sizeof(digits);
+        unsigned magnitude = value < 0 ? 0u - static_cast<unsigned>(value) : static_cast<unsigned>(value);
+        do
+        {
+            digits[--pos] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (value < 0) digits[--pos] = '-';
+        put(digits + pos, sizeof(digits) - pos);
+    }
+
+    /**
+     * @brief 写出缓冲区内全部字节
+     */
+    void write_out()
+    {
+        if (len == 0) return;
+        _write_all(buffer, len);
+        len = 0;
+    }
+
+private:
+    static const size_t BUFFER_SIZE = 1 << 20;
+    char buffer[BUFFER_SIZE];     // 输出缓冲区
+    size_t len = 0;               // 已缓冲字节数
+
+    /**
+     * @brief 直到全部写出为止，被信号中断时重试
+     */
+    void _write_all(const char *text, size_t length)
+    {
+        while (length > 0)
+        {
+#ifdef _WIN32
+            int done = _write(1, text, static_cast<unsigned>(length));
+#else
+            ssize_t done = write(1, text, length);
+#endif
+            write_calls++;
+            if (done < 0 and errno == EINTR) continue;
+            if (done <= 0) return;
+            text += done;
+            length -= done;
+            bytes += done;
+        }
+    }
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 输入缓冲 ═══════════════════════════════╗*/
+/**
+ * @brief     标准输入的缓冲读取器
+ * @details   缓冲区耗尽时才调用一次read(2)，取回当前已到达的全部数据(至多缓冲区大小):
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 交互管道上read只在无数据可读时等待，有数据即返回，不要求读满       │
+ * │ 2. 只在记号未结束(或尚未开始)时补充数据，判题器按行发送，记号后必有  │
+ * │    空白，因此不会等待判题器尚未发送的下一条消息                       │
+ * │ 3. 整数按字节累加，数字判断为一次无符号比较                           │
+ * │ 4. 需要等待输入前先写出缓冲的输出，判题器据此发送下一段输入           │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class InputReader
+{
+public:
+    long long read_calls = 0;     // read(2)调用次数
+
+    explicit InputReader(OutputWriter &writer) : writer(writer) {}
+
+    /**
+     * @brief 读取一个十进制整数(可带负号)，输入结束时返回0
+     */
+    int read_int()
+    {
+        int c = _skip_space();
+        bool negative = c == '-';
+        if (negative) c = _next();
+        int value = 0;
+        while (static_cast<unsigned>(c - '0') < 10)
+        {
+            value = value * 10 + (c - '0');
+            c = _next();
+        }
+        return negative ? -value : value;
+    }
+
+    /**
+     * @brief 跳过一个由非空白字符组成的记号(TIMESTAMP、GARBAGE等关键字或整数)
+     */
+    void skip_token()
+    {
+        int c = _skip_space();
+        while (c > ' ') c = _next();
+    }
+
+private:
+    static const int BUFFER_SIZE = 1 << 16;
+    OutputWriter &writer;         // 等待输入前需写出的输出
+    char buffer[BUFFER_SIZE];     // 输入缓冲区
+    int pos = 0;                  // 下一个未读字节
+    int len = 0;                  // 缓冲区有效字节数
+
+    /**
+     * @brief 取下一个字节并前移，输入结束时返回-1
+     */
+    int _next()
+    {
+        if (pos == len and not _fill()) return -1;
+        return static_cast<unsigned char>(buffer[pos++]);
+    }
+
+    /**
+     * @brief 跳过空白，返回第一个非空白字节(已消费)，输入结束时返回-1
+     */
+    int _skip_space()
+    {
+        int c = _next();
+        while (c >= 0 and c <= ' ') c = _next();
+        return c;
+    }
+
+    /**
+     * @brief 补充缓冲区
+     * @return 输入结束或出错时返回false
+     */
+    bool _fill()
+    {
+        writer.write_out();
+        read_calls++;
+#ifdef _WIN32
+        int got = _read(0, buffer, BUFFER_SIZE);
+#else
+        ssize_t got = read(0, buffer, BUFFER_SIZE);
+        while (got < 0 and errno == EINTR)
+        {
+            read_calls++;
+            got = read(0, buffer, BUFFER_SIZE);
+        }
+#endif
+        pos = 0;
+        len = got > 0 ? static_cast<int>(got) : 0;
+        return len > 0;
+    }
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 轨迹格式 ═══════════════════════════════╗*/
+/**
+ * @brief     轨迹文件格式
+ * @details   魔数"PCTRACE\0"(8字节)后为若干帧，每次刷新输出为一帧(第0帧为"OK"):
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 输入整数个数(varint)，每个整数zigzag后按varint编码                 │
+ * │ 2. 输出字节数(varint)，原样输出字节                                   │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+static const char TRACE_MAGIC[8] = "PCTRACE";
+
+/**
+ * @brief     会话状态
+ */
+struct Session
+{
+    std::vector<int> inputs;      // 本帧输入整数
+    std::vector<char> output;     // 本帧输出字节(录制与回放)
+#ifndef SESSION_REPLAY
+    OutputWriter writer;          // 标准输出写出器
+    InputReader reader{writer};   // 标准输入读取器
+#endif
+#ifdef SESSION_RECORD
+    FILE *trace = nullptr;        // 轨迹文件
+#endif
+#ifdef SESSION_REPLAY
+    std::vector<char> data;       // 整个轨迹
+    size_t cursor = 0;            // 下一帧位置
+    size_t input_pos = 0;         // 本帧已读取的输入数
+    size_t expected_begin = 0;    // 本帧录制输出在轨迹中的位置
+    size_t expected_size = 0;     // 本帧录制输出字节数
+    bool check = true;            // 是否比对输出
+    int frames = 0;               // 已回放帧数
+    int mismatched = 0;           // 输出不一致的帧数
+    bool broken = false;          // 输入不同步或轨迹损坏
+    std::chrono::steady_clock::time_point begin;
+#endif
+};
+
+static Session SESSION;
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 变长编码 ═══════════════════════════════╗*/
+#if defined(SESSION_RECORD) || defined(SESSION_REPLAY)
+#ifdef SESSION_RECORD
+/**
+ * @brief     追加一个zigzag变长整数
+ */
+static void put_varint(std::vector<char> &buffer, long long value)
+{
+    unsigned long long bits = (static_cast<unsigned long long>(value) << 1) ^ (value < 0 ? ~0ULL : 0ULL);
+    while (bits >= 0x80)
+    {
+        buffer.push_back(static_cast<char>((bits & 0x7f) | 0x80));
+        bits >>= 7;
+    }
+    buffer.push_back(static_cast<char>(bits));
+}
+#endif
+
+#ifdef SESSION_REPLAY
+/**
+ * @brief     读取一个zigzag变长整数
+ * @return    越界时置ok为false并返回0
+ */
+static long long get_varint(const std::vector<char> &buffer, size_t &cursor, bool &ok)
+{
+    unsigned long long bits = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (cursor >= buffer.size())
+        {
+            ok = false;
+            return 0;
+        }
+        unsigned char byte = static_cast<unsigned char>(buffer[cursor++]);
+        bits |= static_cast<unsigned long long>(byte & 0x7f) << shift;
+        if (byte < 0x80) return static_cast<long long>(bits >> 1) ^ -static_cast<long long>(bits & 1);
+    }
+    ok = false;
+    return 0;
+}
+#endif
+#endif
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 输入 ═══════════════════════════════╗*/
+int session_read_int()
+{
+#ifdef SESSION_REPLAY
+    // ◆ 输入不同步时继续运行只会访问无效数据，直接输出汇总并退出
+    if (SESSION.input_pos >= SESSION.inputs.size())
+    {
+        fprintf(stderr, "REPLAY input exhausted at frame %d\n", SESSION.frames);
+        SESSION.broken = true;
+        std::exit(session_close_replay());
+    }
+    return SESSION.inputs[SESSION.input_pos++];
+#else
+    int value = SESSION.reader.read_int();
+#ifdef SESSION_RECORD
+    SESSION.inputs.push_back(value);
+#endif
+    return value;
+#endif
+}
+
+void session_skip_token()
+{
+#ifndef SESSION_REPLAY
+    SESSION.reader.skip_token();
+#endif
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 输出 ═══════════════════════════════╗*/
+void session_put_str(const char *text, size_t length)
+{
+#ifndef SESSION_REPLAY
+    SESSION.writer.put(text, length);
+#endif
+#if defined(SESSION_RECORD) || defined(SESSION_REPLAY)
+    SESSION.output.insert(SESSION.output.end(), text, text + length);
+#endif
+}
+
+void session_put_str(const char *text)
+{
+    session_put_str(text, std::strlen(text));
+}
+
+void session_put_str(const std::string &text)
+{
+    session_put_str(text.data(), text.size());
+}
+
+void session_put_char(char c)
+{
+#ifndef SESSION_REPLAY
+    SESSION.writer.put_char(c);
+#endif
+#if defined(SESSION_RECORD) || defined(SESSION_REPLAY)
+    SESSION.output.push_back(c);
+#endif
+}
+
+void session_put_int(int value)
+{
+#if defined(SESSION_RECORD) || defined(SESSION_REPLAY)
+    std::string digits = std::to_string(value);
+    SESSION.output.insert(SESSION.output.end(), digits.begin(), digits.end());
+#endif
+#ifndef SESSION_REPLAY
+    SESSION.writer.put_int(value);
+#endif
+}
+
+void session_finish(int ticks)
+{
+#ifndef SESSION_REPLAY
+    SESSION.writer.write_out();
+    char line[256];
+    snprintf(line, sizeof(line), "IO_STATS ticks=%d read_calls=%lld write_calls=%lld read_per_tick=%.3f write_per_tick=%.3f out_bytes=%lld",
+             ticks, SESSION.reader.read_calls, SESSION.writer.write_calls,
+             static_cast<double>(SESSION.reader.read_calls) / std::max(ticks, 1),
+             static_cast<double>(SESSION.writer.write_calls) / std::max(ticks, 1), SESSION.writer.bytes);
+    emit_stats(line);
+#else
+    (void)ticks;
+#endif
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 刷新与帧边界 ═══════════════════════════════╗*/
+#ifdef SESSION_REPLAY
+/**
+ * @brief     载入下一帧的输入，并记下录制输出的位置
+ * @return    轨迹已读完或损坏时返回false
+ */
+static bool load_frame()
+{
+    SESSION.inputs.clear();
+    SESSION.input_pos = 0;
+    SESSION.expected_size = 0;
+    if (SESSION.cursor >= SESSION.data.size()) return false;
+
+    bool ok = true;
+    size_t count = get_varint(SESSION.data, SESSION.cursor, ok);
+    for (size_t i = 0; i < count and ok; ++i)
+        SESSION.inputs.push_back(static_cast<int>(get_varint(SESSION.data, SESSION.cursor, ok)));
+    size_t size = get_varint(SESSION.data, SESSION.cursor, ok);
+    if (not ok or size > SESSION.data.size() - SESSION.cursor) return false;
+    SESSION.expected_begin = SESSION.cursor;
+    SESSION.expected_size = size;
+    SESSION.cursor += size;
+    return true;
+}
+
+/**
+ * @brief     报告一帧的首个不一致行
+ */
+static void report_mismatch(const char *expected, size_t expected_size)
+{
+    const std::vector<char> &actual = SESSION.output;
+    size_t pos = 0;
+    while (pos < expected_size and pos < actual.size() and expected[pos] == actual[pos]) pos++;
+    size_t line_begin = pos;
+    while (line_begin > 0 and expected[line_begin - 1] != '\n') line_begin--;
+    auto line_end = [&](const char *text, size_t size) {
+        size_t end = line_begin;
+        while (end < size and text[end] != '\n') end++;
+        return static_cast<int>(end - line_begin);
+    };
+    fprintf(stderr, "REPLAY mismatch frame=%d expected=\"%.*s\" actual=\"%.*s\"\n", SESSION.frames,
+            line_end(expected, expected_size), expected + line_begin,
+            line_end(actual.data(), actual.size()), actual.data() + line_begin);
+}
+#endif
+
+void session_flush()
+{
+#ifdef SESSION_RECORD
+    // ◆ 录制：本帧编码落盘，先于输出写出，保证判题器收到输出时轨迹已完整
+    if (SESSION.trace == nullptr)
+    {
+        SESSION.trace = fopen(SESSION_RECORD, "wb");
+        if (SESSION.trace != nullptr) fwrite(TRACE_MAGIC, 1, sizeof(TRACE_MAGIC), SESSION.trace);
+    }
+    std::vector<char> frame;
+    put_varint(frame, SESSION.inputs.size());
+    for (int value : SESSION.inputs) put_varint(frame, value);
+    put_varint(frame, SESSION.output.size());
+    frame.insert(frame.end(), SESSION.output.begin(), SESSION.output.end());
+    if (SESSION.trace != nullptr)
+    {
+        fwrite(frame.data(), 1, frame.size(), SESSION.trace);
+        fflush(SESSION.trace);
+    }
+    SESSION.inputs.clear();
+    SESSION.output.clear();
+#endif
+
+#ifdef SESSION_REPLAY
+    // ◆ 回放：校验本帧，再载入下一帧
+    if (SESSION.input_pos != SESSION.inputs.size() and not SESSION.broken)
+    {
+        fprintf(stderr, "REPLAY input not consumed at frame %d\n", SESSION.frames);
+        SESSION.broken = true;
+    }
+    const char *expected = SESSION.data.data() + SESSION.expected_begin;
+    if (SESSION.check and (SESSION.output.size() != SESSION.expected_size or
+                           std::memcmp(SESSION.output.data(), expected, SESSION.expected_size) != 0))
+    {
+        if (SESSION.mismatched == 0) report_mismatch(expected, SESSION.expected_size);
+        SESSION.mismatched++;
+    }
+    SESSION.frames++;
+    SESSION.output.clear();
+    load_frame();
+#endif
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 回放控制 ═══════════════════════════════╗*/
+#ifdef SESSION_REPLAY
+bool session_open_replay(const char *path, bool check)
+{
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) return false;
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    SESSION.data.resize(size > 0 ? size : 0);
+    size_t got = fread(SESSION.data.data(), 1, SESSION.data.size(), file);
+    fclose(file);
+    if (got != SESSION.data.size() or got < sizeof(TRACE_MAGIC) or
+        std::memcmp(SESSION.data.data(), TRACE_MAGIC, sizeof(TRACE_MAGIC)) != 0) return false;
+
+    SESSION.cursor = sizeof(TRACE_MAGIC);
+    SESSION.check = check;
+    SESSION.begin = std::chrono::steady_clock::now();
+    return load_frame();
+}
+
+int session_close_replay()
+{
+    double wall_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - SESSION.begin).count();
+    bool complete = SESSION.cursor >= SESSION.data.size() and SESSION.expected_size == 0 and SESSION.inputs.empty();
+    fprintf(stderr, "REPLAY frames=%d mismatched=%d%s wall_ms=%.1f\n", SESSION.frames, SESSION.mismatched,
+            SESSION.broken or not complete ? " desync=1" : "", wall_ms);
+    return SESSION.mismatched > 0 or SESSION.broken or not complete ? 1 : 0;
+}
+#endif
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
@@ -0,0 +1,85 @@
+/*━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *  ███████╗███████╗███████╗███████╗██╗ ██████╗ ███╗   ██╗  ██╗  ██╗
+ *  ██╔════╝██╔════╝██╔════╝██╔════╝██║██╔═══██╗████╗  ██║  ██║  ██║
+ *  ███████╗█████╗  ███████╗███████╗██║██║   ██║██╔██╗ ██║  ███████║
+ *  ╚════██║██╔══╝  ╚════██║╚════██║██║██║   ██║██║╚██╗██║  ██╔══██║
+ *  ███████║███████╗███████║███████║██║╚██████╔╝██║ ╚████║  ██║  ██║
+ *  ╚══════╝╚══════╝╚══════╝╚══════╝╚═╝ ╚═════╝ ╚═╝  ╚═══╝  ╚═╝  ╚═╝
+ *
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ * 【模块功能】
+ * ┌─────────────────┬───────────────────────────────────────────────────────────┐
+ * │ 交互输入输出     │ 与判题器交互的全部读写都经由本模块                          │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 会话录制         │ 以-DSESSION_RECORD=\"<路径>\"编译时，把输入整数与输出字节   │
+ * │                 │ 按每次刷新写成二进制轨迹                                    │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 会话回放         │ 以-DSESSION_REPLAY编译时(replay/目标)，进程内从轨迹取输入，  │
+ * │                 │ 不经管道与判题器，逐帧比对输出或仅计时                     │
+ * └─────────────────┴───────────────────────────────────────────────────────────┘
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━*/
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief     读取一个整数
+ * @details   录制模式同时记入当前帧，回放模式从当前帧依次取出
+ */
+int session_read_int();
+
+/**
+ * @brief     跳过一个记号(如"TIMESTAMP"及其后的时间戳)
+ * @details   被跳过的内容不影响决策，不录制，回放时为空操作
+ */
+void session_skip_token();
+
+/**
+ * @brief     追加输出字符串(不立即写出)
+ */
+void session_put_str(const char *text, size_t length);
+void session_put_str(const char *text);
+void session_put_str(const std::string &text);
+
+/**
+ * @brief     追加输出一个字符(不立即写出)
+ */
+void session_put_char(char c);
+
+/**
+ * @brief     追加输出一个十进制整数(不立即写出)
+ */
+void session_put_int(int value);
+
+/**
+ * @brief     标记一次完整应答(协议点)，结束当前帧
+ * @details   输出仍留在缓冲区，等到需要等待输入或程序结束时一次写出:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 录制: 本帧追加到轨迹文件，先于输出写出(判题器可能随即结束进程)        │
+ * │ 回放: 校验本帧输入已全部读取，检查模式下比对输出，然后载入下一帧       │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+void session_flush();
+
+/**
+ * @brief     写出剩余输出，并经emit_stats输出IO_STATS行(read/write调用次数及每时间片均值)
+ * @param     ticks 总时间片数
+ */
+void session_finish(int ticks);
+
+#ifdef SESSION_REPLAY
+/**
+ * @brief     打开回放轨迹
+ * @param     path 轨迹文件路径
+ * @param     check true时逐帧比对输出，false时只计时
+ * @return    轨迹可读且格式正确时返回true
+ */
+bool session_open_replay(const char *path, bool check);
+
+/**
+ * @brief     结束回放并输出汇总行
+ * @return    退出码，输出不一致或轨迹未读完时为1
+ */
+int session_close_replay();
+#endif
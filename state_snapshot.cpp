@@ -0,0 +1,490 @@
+/*━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *  ███████╗████████╗ █████╗ ████████╗███████╗
+ *  ██╔════╝╚══██╔══╝██╔══██╗╚══██╔══╝██╔════╝
+ *  ███████╗   ██║   ███████║   ██║   █████╗
+ *  ╚════██║   ██║   ██╔══██║   ██║   ██╔══╝
+ *  ███████║   ██║   ██║  ██║   ██║   ███████╗
+ *  ╚══════╝   ╚═╝   ╚═╝  ╚═╝   ╚═╝   ╚══════╝
+ *
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ * 【模块功能】
+ * ┌─────────────────┬───────────────────────────────────────────────────────────┐
+ * │ 状态保存         │ 将控制器、对象、活跃请求和各磁盘完整状态写成紧凑二进制文件  │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 状态恢复         │ mmap映射快照文件，顺序memcpy恢复，毫秒级得到运行中途状态    │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 用途             │ 读取规划、写入放置与GC在真实中途状态上的可重复微基准        │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 布局校验         │ 校验空闲链表、free_cells、对象副本与外部对象集合一致        │
+ * └─────────────────┴───────────────────────────────────────────────────────────┘
+ *
+ * 【说明】
+ *   1. 以本机字节序保存，只保证同一平台、同一版本的程序之间可读
+ *   2. GC预规划与GC匹配器属于缓存，不保存；恢复后在下次GC时重新规划
+ *   3. 写入与时间片耗时统计、时间预算不保存；第二轮的输入缓存(INPUT)不属于控制器状态
+ *   4. unordered_set按保存时的遍历顺序重新插入，不保证桶内顺序与原进程一致
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━*/
+
+#include "ctrl_disk_obj_req.h"  // ⟪控制器、磁盘、对象、请求相关⟫
+#include "data_analysis.h"      // ⟪数据分析相关⟫
+#include <cstdio>
+#include <cstring>
+#include <string>
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*╔══════════════════════════════ 文件格式 ═══════════════════════════════╗*/
+/**
+ * @brief     快照文件头
+ * @details   依次为:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 魔数"PCSTATE\0"(8字节) / 版本 / T M N V G k1 k2                   │
+ * │ 2. 控制器: 时间戳、请求索引、计数、两类过滤请求列表                   │
+ * │ 3. 对象: 数量，每个对象的属性、热度、各副本单元与请求ID列表            │
+ * │ 4. 请求: [req_105_idx, req_new_idx]区间内请求环形缓冲区的原始内容      │
+ * │ 5. 磁盘: 磁头、令牌、准入模型、分区表(含空闲块与外部对象)、单元格   │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+static const char STATE_MAGIC[8] = "PCSTATE";
+static const int STATE_VERSION = 4;
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 控制器状态保存 ═══════════════════════════════╗*/
+/**
+ * @brief     保存完整控制器状态
+ * @param     path 快照文件路径
+ * @details   全部内容先写入内存缓冲区，再一次fwrite落盘
+ */
+void Controller::save_state(const std::string &path)
+{
+    StateWriter out;
+    out.buffer.reserve(4 << 20);
+
+    // ◆ 文件头与系统参数
+    out.put(STATE_MAGIC);
+    out.put(STATE_VERSION);
+    for (int param : {T, M, N, V, G, k1, k2}) out.put(param);
+
+    // ◆ 控制器
+    out.put(timestamp);
+    out.put(timestamp_real);
+    out.put(req_105_idx);
+    out.put(req_new_idx);
+    out.put(busy_count);
+    out.put(over_load_count);
+    out.put(write_count);
+    out.put_vector(over_load_reqs);
+    out.put_vector(busy_reqs);
+    out.put_array(tag_wait_hist, MAX_TAG_NUM + 1);
+
+    // ◆ 对象(已删除对象的id为0，不保存)
+    int obj_num = 0;
+    for (auto &obj : OBJECTS) obj_num += obj.id != 0;
+    out.put(obj_num);
+    for (auto &obj : OBJECTS)
+    {
+        if (obj.id == 0) continue;
+        out.put(obj.id);
+        out.put(obj.size);
+        out.put(obj.tag);
+        out.put(obj.occupied);
+        out.put(obj.heat);
+        out.put(obj.heat_time);
+        for (auto &[disk_id, units] : obj.replicas)
+        {
+            out.put(disk_id);
+            out.put_vector(units);
+        }
+        out.put_vector(std::vector<int>(obj.req_ids.begin(), obj.req_ids.end()));
+    }
+
+    // ◆ 活跃请求
+    for (int req_id = req_105_idx; req_id <= req_new_idx; ++req_id) out.put(REQS[req_id % LEN_REQ]);
+
+    // ◆ 磁盘
+    for (int i = 1; i <= N; ++i) DISKS[i].save_state(out);
+
+    FILE *file = fopen(path.c_str(), "wb");
+    assert(file != nullptr);
+    fwrite(out.buffer.data(), 1, out.buffer.size(), file);
+    fclose(file);
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 控制器状态恢复 ═══════════════════════════════╗*/
+/**
+ * @brief     映射快照文件并恢复完整控制器状态
+ * @param     path 快照文件路径
+ * @return    是否加载成功
+ * @details   须在新构造的控制器上调用:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. mmap只读映射整个文件(Windows下退化为一次性读入内存)                │
+ * │ 2. 恢复系统参数并重新执行数据分析(频率表为编译期常量)                 │
+ * │ 3. 顺序恢复控制器、对象、请求，再由各磁盘恢复自身状态                 │
+ * │ 4. 任一步越界或魔数、版本不符即返回false                              │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+bool Controller::load_state(const std::string &path)
+{
+    // ◆ 映射文件
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary);
+    if (not file) return false;
+    std::vector<char> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const char *data = content.data();
+    size_t size = content.size();
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 or st.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+    size_t size = st.st_size;
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) return false;
+    const char *data = static_cast<const char *>(mapped);
+#endif
+    StateReader in(data, size);
+
+    // ◆ 文件头与系统参数
+    bool valid = std::memcmp(in.get<std::array<char, 8>>().data(), STATE_MAGIC, 8) == 0 and
+                 in.get<int>() == STATE_VERSION;
+    if (valid)
+    {
+        for (int *param : {&T, &M, &N, &V, &G, &k1, &k2}) *param = in.get<int>();
+        process_data_analysis();
+
+        // ◆ 控制器
+        timestamp = in.get<int>();
+        timestamp_real = in.get<int>();
+        req_105_idx = in.get<int>();
+        req_new_idx = in.get<int>();
+        busy_count = in.get<int>();
+        over_load_count = in.get<int>();
+        write_count = in.get<int>();
+        in.get_vector(over_load_reqs);
+        in.get_vector(busy_reqs);
+        std::vector<LatencyHist> hists;
+        in.get_vector(hists);
+        if (hists.size() != MAX_TAG_NUM + 1) in.ok = false;
+        else std::copy(hists.begin(), hists.end(), tag_wait_hist);
+
+        // ◆ 对象
+        int obj_num = in.get<int>();
+        std::vector<int> req_ids;
+        for (int n = 0; n < obj_num and in.ok; ++n)
+        {
+            int obj_id = in.get<int>();
+            if (obj_id <= 0 or obj_id >= MAX_OBJECT_NUM) { in.ok = false; break; }
+            Object &obj = OBJECTS[obj_id];
+            obj.id = obj_id;
+            obj.size = in.get<int>();
+            obj.tag = in.get<int>();
+            obj.occupied = in.get<bool>();
+            obj.heat = in.get<double>();
+            obj.heat_time = in.get<int>();
+            for (auto &[disk_id, units] : obj.replicas)
+            {
+                disk_id = in.get<int>();
+                in.get_vector(units);
+            }
+            in.get_vector(req_ids);
+            obj.req_ids.clear();
+            obj.req_ids.insert(req_ids.begin(), req_ids.end());
+        }
+
+        // ◆ 活跃请求
+        for (int req_id = req_105_idx; req_id <= req_new_idx and in.ok; ++req_id)
+        {
+            REQS[req_id % LEN_REQ] = in.get<Req>();
+        }
+
+        // ◆ 磁盘
+        for (int i = 1; i <= N and in.ok; ++i)
+        {
+            DISKS[i].controller = this;
+            if (not DISKS[i].load_state(in)) break;
+        }
+        valid = in.ok;
+    }
+
+#ifndef _WIN32
+    munmap(mapped, size);
+#endif
+    return valid;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 磁盘状态保存 ═══════════════════════════════╗*/
+/**
+ * @brief     保存磁盘完整状态
+ * @param     out 写入器
+ * @details   单元格按列存储(对象ID、单元ID各一个数组)，单元格请求展开为(位置, 请求ID)对；
+ *            单元格标签由对象标签推出，不保存
+ */
+void Disk::save_state(StateWriter &out) const
+{
+    // ◆ 磁头、令牌与GC令牌
+    for (int value : {id, size, K, point1, point2, tokens1, tokens2,
+                      prev_read_token1, prev_read_token2, data_size1, data_size2})
+    {
+        out.put(value);
+    }
+    out.put_array(tag_reverse, MAX_TAG_NUM + 1);
+
+    // ◆ 准入控制服务模型(待读单元数由单元格推出)
+    out.put(read_cost1);
+    out.put(read_cost2);
+    out.put_array(pending_arrivals, 3);
+    out.put_array(arrival_rate, 3);
+
+    // ◆ 请求时延统计
+    out.put_array(wait_hist, 3);
+
+    // ◆ 分区表
+    out.put(static_cast<int>(part_tables.size()));
+    for (auto &tag_parts : part_tables)
+    {
+        out.put(static_cast<int>(tag_parts.size()));
+        for (auto &part : tag_parts)
+        {
+            for (int value : {part.start, part.end, part.free_cells, part.last_write_pos, part.tag, part.size})
+            {
+                out.put(value);
+            }
+
+            // ● 空闲块链表(按链表顺序的起止位置)
+            std::vector<int> blocks;
+            for (int idx = part.free_list_head; idx != FreeBlock::NIL; idx = block_pool.nodes[idx].next)
+            {
+                blocks.push_back(block_pool.nodes[idx].start);
+                blocks.push_back(block_pool.nodes[idx].end);
+            }
+            out.put_vector(blocks);
+
+            // ● 外部对象(按集合遍历顺序的对象ID与引用计数)
+            std::vector<int> other_objs;
+            for (int obj_id : part.other_objs)
+            {
+                other_objs.push_back(obj_id);
+                other_objs.push_back(part.other_objs.count(obj_id));
+            }
+            out.put_vector(other_objs);
+        }
+    }
+
+    // ◆ 单元格
+    std::vector<int> obj_ids(size + 1), unit_ids(size + 1), cell_reqs;
+    for (int pos = 1; pos <= size; ++pos)
+    {
+        obj_ids[pos] = cells[pos].obj_id;
+        unit_ids[pos] = cells[pos].unit_id;
+        for (int req_id : cells[pos].req_ids)
+        {
+            cell_reqs.push_back(pos);
+            cell_reqs.push_back(req_id);
+        }
+    }
+    out.put_vector(obj_ids);
+    out.put_vector(unit_ids);
+    out.put_vector(cell_reqs);
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 磁盘状态恢复 ═══════════════════════════════╗*/
+/**
+ * @brief     恢复磁盘完整状态
+ * @param     in 读取器
+ * @return    是否读取成功
+ * @details   分区表整体读入后再设置单元格归属，避免分区指针因扩容失效；
+ *            空闲块按保存顺序追加，无需逐单元重建
+ */
+bool Disk::load_state(StateReader &in)
+{
+    // ◆ 磁头、令牌与GC令牌
+    for (int *value : {&id, &size, &K, &point1, &point2, &tokens1, &tokens2,
+                       &prev_read_token1, &prev_read_token2, &data_size1, &data_size2})
+    {
+        *value = in.get<int>();
+    }
+    std::vector<int> values;
+    in.get_vector(values);
+    if (values.size() != MAX_TAG_NUM + 1 or size <= 0 or size >= MAX_DISK_SIZE) return in.ok = false;
+    std::copy(values.begin(), values.end(), tag_reverse);
+
+    // ◆ 准入控制服务模型
+    read_cost1 = in.get<double>();
+    read_cost2 = in.get<double>();
+    in.get_vector(values);
+    std::vector<double> rates;
+    in.get_vector(rates);
+    if (values.size() != 3 or rates.size() != 3) return in.ok = false;
+    std::copy(values.begin(), values.end(), pending_arrivals);
+    std::copy(rates.begin(), rates.end(), arrival_rate);
+
+    // ◆ 请求时延统计
+    std::vector<LatencyHist> hists;
+    in.get_vector(hists);
+    if (hists.size() != 3) return in.ok = false;
+    std::copy(hists.begin(), hists.end(), wait_hist);
+
+    // ◆ GC预规划不保存，恢复后重新规划
+    _drop_gc_plan();
+    gc_plan_k = 0;
+
+    // ◆ 分区表
+    std::vector<std::vector<int>> blocks, other_objs;
+    part_tables.assign(in.get<int>(), {});
+    for (auto &tag_parts : part_tables)
+    {
+        int part_num = in.get<int>();
+        for (int n = 0; n < part_num and in.ok; ++n)
+        {
+            int start = in.get<int>(), end = in.get<int>(), free_cells = in.get<int>();
+            int last_write_pos = in.get<int>(), tag = in.get<int>(), part_size = in.get<int>();
+            tag_parts.push_back(Part(start, end, free_cells, last_write_pos, tag, part_size));
+            blocks.emplace_back();
+            in.get_vector(blocks.back());
+            other_objs.emplace_back();
+            in.get_vector(other_objs.back());
+        }
+    }
+    if (not in.ok) return false;
+
+    // ● 空闲块链表与外部对象
+    block_pool.reset(size / 2 + blocks.size() + 1);
+    int part_idx = 0;
+    for (auto &tag_parts : part_tables)
+    {
+        for (auto &part : tag_parts)
+        {
+            part.pool = &block_pool;
+            auto &part_blocks = blocks[part_idx];
+            for (size_t b = 0; b + 1 < part_blocks.size(); b += 2) part.append_free_block(part_blocks[b], part_blocks[b + 1]);
+            auto &part_others = other_objs[part_idx];
+            for (size_t o = 0; o + 1 < part_others.size(); o += 2) part.other_objs.add(part_others[o], part_others[o + 1]);
+            part_idx++;
+        }
+    }
+
+    // ◆ 单元格
+    cells.assign(size + 1, Cell());
+    for (auto &tag_parts : part_tables)
+    {
+        for (auto &part : tag_parts)
+        {
+            for (int pos = std::min(part.start, part.end); pos <= std::max(part.start, part.end); ++pos)
+            {
+                cells[pos].part = &part;
+            }
+        }
+    }
+    std::vector<int> obj_ids, unit_ids, cell_reqs;
+    in.get_vector(obj_ids);
+    in.get_vector(unit_ids);
+    in.get_vector(cell_reqs);
+    if (static_cast<int>(obj_ids.size()) != size + 1 or unit_ids.size() != obj_ids.size()) return in.ok = false;
+    for (int pos = 1; pos <= size; ++pos)
+    {
+        cells[pos].obj_id = obj_ids[pos];
+        cells[pos].unit_id = unit_ids[pos];
+        cells[pos].tag = controller->OBJECTS[obj_ids[pos]].tag;
+    }
+    pending_map.reset(size);
+    for (size_t r = 0; r + 1 < cell_reqs.size(); r += 2)
+    {
+        pending_map.set(cell_reqs[r]);
+        cells[cell_reqs[r]].req_ids.insert(cell_reqs[r + 1]);
+    }
+    return in.ok;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 布局校验 ═══════════════════════════════╗*/
+/**
+ * @brief     校验磁盘布局一致性
+ * @return    违例数，0表示通过
+ * @details   检查项:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 各分区空闲链表的完整性与一致性(含free_cells)                      │
+ * │ 2. 占用单元的对象在本盘的副本中，对应单元位置指向该单元               │
+ * │ 3. 对象在本盘的每个副本单元都存放着该对象的对应单元                   │
+ * │ 4. 外部对象集合与单元格状态一致                                       │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+int Disk::verify_layout()
+{
+    int errors = 0;
+
+    // ◆ 空闲链表
+    for (auto &tag_parts : part_tables)
+    {
+        for (auto &part : tag_parts)
+        {
+            errors += part._verify_free_list_integrity();
+            errors += part._verify_free_list_consistency(this);
+        }
+    }
+
+    // ◆ 单元格 -> 副本
+    for (int pos = 1; pos <= size; ++pos)
+    {
+        const Cell &cell = cells[pos];
+        if (cell.obj_id == 0) continue;
+        Object &obj = controller->OBJECTS[cell.obj_id];
+        bool found = false;
+        for (auto &[disk_id, units] : obj.replicas)
+        {
+            if (disk_id != id) continue;
+            found = cell.unit_id >= 1 and cell.unit_id <= static_cast<int>(units.size()) and units[cell.unit_id - 1] == pos;
+        }
+        if (not found or cell.tag != obj.tag) errors++;
+    }
+
+    // ◆ 副本 -> 单元格
+    for (auto &obj : controller->OBJECTS)
+    {
+        if (obj.replicas.empty()) continue;
+        for (auto &[disk_id, units] : obj.replicas)
+        {
+            if (disk_id != id) continue;
+            for (int u = 0; u < static_cast<int>(units.size()); ++u)
+            {
+                const Cell &cell = cells[units[u]];
+                if (cell.obj_id != obj.id or cell.unit_id != u + 1) errors++;
+            }
+        }
+    }
+
+    // ◆ 外部对象集合
+    for (auto &tag_parts : part_tables)
+    {
+        for (auto &part : tag_parts)
+        {
+            if (part.tag == 0) continue;
+            IndexedSet expected;
+            for (int pos = std::min(part.start, part.end); pos <= std::max(part.start, part.end); ++pos)
+            {
+                if (cells[pos].obj_id != 0 and cells[pos].tag != part.tag) expected.add(cells[pos].obj_id);
+            }
+            if (expected.size() != part.other_objs.size()) errors++;
+            for (int obj_id : expected)
+            {
+                if (not part.other_objs.contains(obj_id)) errors++;
+            }
+        }
+    }
+    return errors;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
\ No newline at end of file
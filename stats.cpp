@@ -0,0 +1,218 @@
+/*━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *  ███████╗████████╗ █████╗ ████████╗███████╗
+ *  ██╔════╝╚══██╔══╝██╔══██╗╚══██╔══╝██╔════╝
+ *  ███████╗   ██║   ███████║   ██║   ███████╗
+ *  ╚════██║   ██║   ██╔══██║   ██║   ╚════██║
+ *  ███████║   ██║   ██║  ██║   ██║   ███████║
+ *  ╚══════╝   ╚═╝   ╚═╝  ╚═╝   ╚═╝   ╚══════╝
+ *
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ * 【模块功能】
+ * ┌─────────────────┬───────────────────────────────────────────────────────────┐
+ * │ 统计记录         │ 写入放置计数的累加                                        │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 统计导出         │ 按轮输出机器可读的统计行                                   │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 耗时分布         │ 时间片耗时的均值与分位数                                   │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 时延分布         │ 请求时延直方图的按轮导出                                   │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 时间预算         │ 降级等级的调整、切换日志与阶段耗时导出                     │
+ * └─────────────────┴───────────────────────────────────────────────────────────┘
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━*/
+
+#include "stats.h"      // 统计相关
+#include "debug.h"      // 调试工具
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+/*╔══════════════════════════════ 统计行输出 ═══════════════════════════════╗*/
+void emit_stats(const std::string &line)
+{
+    info(line);
+#ifdef STATS
+    fprintf(stderr, "%s\n", line.c_str());
+#endif
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 写入统计记录 ═══════════════════════════════╗*/
+/**
+ * @brief     记录一次写入的放置结果
+ * @details   时间片下标与数据分析模块一致: (timestamp + FRE_PER_SLICING - 1) / FRE_PER_SLICING
+ */
+void WriteStats::record(int tag, int timestamp, WriteStrategy strategy, int scan_steps,
+                        int first_run, int fragments, int size, int leftover)
+{
+    int slice = std::min((timestamp + FRE_PER_SLICING - 1) / FRE_PER_SLICING, STATS_SLICE_NUM - 1);
+    WriteStatsEntry &entry = entries[tag * STATS_SLICE_NUM + slice];
+
+    // ◆ 策略与扫描量
+    entry.objs++;
+    entry.strategy[strategy]++;
+    entry.scan_steps += scan_steps;
+
+    // ◆ 拆分情况
+    if (fragments > 1)
+    {
+        entry.split_objs++;
+        entry.split_units += size - first_run;
+    }
+
+    // ◆ 剩余空洞分桶
+    int bucket = 0;
+    while (bucket < WRITE_HOLE_BUCKETS - 1 and leftover > WRITE_HOLE_BOUNDS[bucket]) bucket++;
+    entry.hole[bucket]++;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 写入统计导出 ═══════════════════════════════╗*/
+/**
+ * @brief     输出本轮的写入统计
+ * @details   仅输出写入过对象的(标签, 时间片)，每条一行，字段为key=value
+ */
+void WriteStats::dump(int round) const
+{
+    for (int tag = 1; tag <= MAX_TAG_NUM; ++tag)
+    {
+        for (int slice = 0; slice < STATS_SLICE_NUM; ++slice)
+        {
+            const WriteStatsEntry &entry = entries[tag * STATS_SLICE_NUM + slice];
+            if (entry.objs == 0) continue;
+
+            std::ostringstream line;
+            line << "WRITE_STATS round=" << round << " tag=" << tag << " slice=" << slice
+                 << " objs=" << entry.objs;
+            for (int s = 0; s < WS_NUM; ++s)
+            {
+                line << " " << WRITE_STRATEGY_NAMES[s] << "=" << entry.strategy[s];
+            }
+            for (int b = 0; b < WRITE_HOLE_BUCKETS; ++b)
+            {
+                line << " hole" << b << "=" << entry.hole[b];
+            }
+            line << " split_objs=" << entry.split_objs
+                 << " split_units=" << entry.split_units
+                 << " scan_steps=" << entry.scan_steps;
+            emit_stats(line.str());
+        }
+    }
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 时间片耗时导出 ═══════════════════════════════╗*/
+/**
+ * @brief     输出本轮各类时间片的耗时分布
+ * @details   分位数取排序后的下标 ⌊p × (n-1)⌋
+ */
+void TickStats::dump(int round) const
+{
+    for (int kind = 0; kind < TK_NUM; ++kind)
+    {
+        if (micros[kind].empty()) continue;
+
+        std::vector<int> sorted = micros[kind];
+        std::sort(sorted.begin(), sorted.end());
+        long long total = 0;
+        for (int us : sorted) total += us;
+        auto percentile = [&](double p) { return sorted[static_cast<size_t>(p * (sorted.size() - 1))]; };
+
+        std::ostringstream line;
+        line << "TICK_STATS round=" << round << " kind=" << TICK_KIND_NAMES[kind]
+             << " ticks=" << sorted.size()
+             << " mean_us=" << total / static_cast<long long>(sorted.size())
+             << " p50_us=" << percentile(0.5)
+             << " p99_us=" << percentile(0.99)
+             << " max_us=" << sorted.back();
+        emit_stats(line.str());
+    }
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 请求时延导出 ═══════════════════════════════╗*/
+/**
+ * @brief     输出本轮累计的请求时延分布
+ * @details   无样本时不输出；除分位数外附带非零桶，格式为b<时延>=<计数>
+ */
+void LatencyHist::dump(int round, const char *scope, int id, int sub) const
+{
+    if (total_count == 0) return;
+
+    std::ostringstream line;
+    line << "LATENCY_STATS round=" << round << " scope=" << scope << " id=" << id;
+    if (sub >= 0) line << " head=" << sub;
+    line << " count=" << total_count
+         << " mean=" << static_cast<double>(total_sum) / total_count
+         << " p50=" << total_percentile(0.5)
+         << " p90=" << total_percentile(0.9)
+         << " p99=" << total_percentile(0.99);
+    for (int bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+    {
+        if (total[bucket] != 0) line << " b" << bucket << "=" << total[bucket];
+    }
+    emit_stats(line.str());
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 时间预算调整 ═══════════════════════════════╗*/
+/**
+ * @brief     结束时间片并调整降级等级
+ * @details   计划耗时按时间片线性均摊: TIME_BUDGET_ROUND_MS × timestamp / round_ticks
+ */
+void TimeBudget::end_tick(int round, int timestamp, int round_ticks)
+{
+    double plan_ms = TIME_BUDGET_ROUND_MS * timestamp / round_ticks;
+
+    // ◆ 单个时间片超限，立即降级
+    if (tick_ms > TIME_BUDGET_TICK_MS and level < DL_NUM - 1)
+    {
+        _switch(round, timestamp, level + 1, plan_ms, "tick");
+        return;
+    }
+    if (timestamp - last_switch < TIME_SWITCH_HOLD) return;
+
+    // ◆ 累计耗时超前降级，余量充足恢复
+    if (round_ms > plan_ms * TIME_STEP_DOWN_RATE and level < DL_NUM - 1)
+    {
+        _switch(round, timestamp, level + 1, plan_ms, "behind");
+    }
+    else if (round_ms < plan_ms * TIME_STEP_UP_RATE and level > DL_FULL)
+    {
+        _switch(round, timestamp, level - 1, plan_ms, "headroom");
+    }
+}
+
+/**
+ * @brief     切换降级等级
+ * @details   切换行经emit_stats输出，-DSTATS构建时可在标准错误直接观察
+ */
+void TimeBudget::_switch(int round, int timestamp, int new_level, double plan_ms, const char *reason)
+{
+    std::ostringstream line;
+    line << "BUDGET_SWITCH round=" << round << " t=" << timestamp
+         << " from=" << DEGRADE_LEVEL_NAMES[level] << " to=" << DEGRADE_LEVEL_NAMES[new_level]
+         << " reason=" << reason << " tick_ms=" << tick_ms
+         << " round_ms=" << round_ms << " plan_ms=" << plan_ms;
+    emit_stats(line.str());
+
+    level = new_level;
+    last_switch = timestamp;
+    switches++;
+}
+
+/**
+ * @brief     输出本轮各阶段累计耗时
+ */
+void TimeBudget::dump(int round) const
+{
+    std::ostringstream line;
+    line << "BUDGET_STATS round=" << round << " level=" << DEGRADE_LEVEL_NAMES[level]
+         << " switches=" << switches << " round_ms=" << round_ms;
+    for (int phase = 0; phase < TP_NUM; ++phase)
+    {
+        line << " " << TIME_PHASE_NAMES[phase] << "_ms=" << phase_ms[phase];
+    }
+    emit_stats(line.str());
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
@@ -0,0 +1,379 @@
+/*━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *  ███████╗████████╗ █████╗ ████████╗███████╗   ██╗  ██╗
+ *  ██╔════╝╚══██╔══╝██╔══██╗╚══██╔══╝██╔════╝   ██║  ██║
+ *  ███████╗   ██║   ███████║   ██║   ███████╗   ███████║
+ *  ╚════██║   ██║   ██╔══██║   ██║   ╚════██║   ██╔══██║
+ *  ███████║   ██║   ██║  ██║   ██║   ███████║   ██║  ██║
+ *  ╚══════╝   ╚═╝   ╚═╝  ╚═╝   ╚═╝   ╚══════╝   ╚═╝  ╚═╝
+ *
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ * 【模块功能】
+ * ┌─────────────────┬───────────────────────────────────────────────────────────┐
+ * │ 写入统计         │ 按标签和时间片记录写入策略命中、剩余空洞和拆分情况          │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 时间片耗时       │ 按GC时间片、GC预规划时间片和普通时间片记录处理耗时分布      │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 请求时延         │ 固定分桶的请求时延直方图，含衰减窗口与按轮累计两套计数      │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 时间预算         │ 按阶段累计耗时，超出计划时逐级降级昂贵策略，有余量时恢复    │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 结果导出         │ 每轮结束时以key=value行格式输出到INFO日志                  │
+ * └─────────────────┴───────────────────────────────────────────────────────────┘
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━*/
+
+#pragma once
+#include "constants.h"      // 系统常量
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/*╔══════════════════════════════ 统计行输出 ═══════════════════════════════╗*/
+/**
+ * @brief     输出一行轮末统计
+ * @details   总是写入INFO日志；以-DSTATS编译时同时写到标准错误，
+ *            使判题器与基准运行无需INFO构建即可看到WRITE/TICK/LATENCY/BUDGET统计
+ */
+void emit_stats(const std::string &line);
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 写入策略定义 ═══════════════════════════════╗*/
+/**
+ * @brief     写入分区选择所命中的策略
+ * @details   与_get_write_disk的查找顺序对应:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ WS_EXACT       : 策略1，同标签分区中存在精确匹配的空闲块               │
+ * │ WS_OWN         : 策略2，同标签分区                                    │
+ * │ WS_REVERSE     : 策略2，尾部相对的配对标签分区(tag_reverse)            │
+ * │ WS_WRITE_START : 策略2，WRITE_START标签分区                          │
+ * │ WS_SIMILAR     : 策略2，读频率相似的标签分区                          │
+ * │ WS_REDUNDANT   : 策略2，冗余区(tag 17)                               │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+enum WriteStrategy
+{
+    WS_EXACT = 0,
+    WS_OWN,
+    WS_REVERSE,
+    WS_WRITE_START,
+    WS_SIMILAR,
+    WS_REDUNDANT,
+    WS_NUM
+};
+
+inline const char* WRITE_STRATEGY_NAMES[WS_NUM] = {
+    "exact", "own", "reverse", "write_start", "similar", "redundant"
+};
+
+// 剩余空洞直方图分桶上界：0, 1, 2, 3-4, 5-8, 9+
+inline const int WRITE_HOLE_BOUNDS[] = {0, 1, 2, 4, 8};
+inline const int WRITE_HOLE_BUCKETS = 6;
+
+// 统计时间片数量(与数据分析模块的时间片划分一致)
+inline const int STATS_SLICE_NUM = (MAX_SLICING_NUM + 1) / FRE_PER_SLICING + 1;
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 写入统计类定义 ═══════════════════════════════╗*/
+/**
+ * @brief     单个(标签, 时间片)的写入计数
+ */
+struct WriteStatsEntry
+{
+    int objs = 0;                               // 写入对象数
+    int strategy[WS_NUM] = {0};                 // 策略命中次数
+    int hole[WRITE_HOLE_BUCKETS] = {0};         // 写入后相邻剩余空洞直方图
+    int split_objs = 0;                         // 被拆分的对象数
+    int split_units = 0;                        // 不在首段内的单元数
+    long long scan_steps = 0;                   // 选择分区时检查的分区数
+};
+
+/**
+ * @brief     写入放置统计
+ * @details   随Controller按轮重置，仅做计数，开销为每次写入常数次自增:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. record: 写入完成后记录主副本的放置结果                             │
+ * │ 2. dump: 每轮结束时输出非零条目，每行形如                             │
+ * │    WRITE_STATS round=1 tag=3 slice=5 objs=.. exact=.. ... hole0=..    │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class WriteStats
+{
+public:
+    std::vector<WriteStatsEntry> entries;   // 按[tag][slice]展开存储
+
+    /**
+     * @brief 构造函数
+     */
+    WriteStats() : entries((MAX_TAG_NUM + 1) * STATS_SLICE_NUM) {}
+
+    /**
+     * @brief 记录一次写入
+     * @param tag 对象标签
+     * @param timestamp 时间戳
+     * @param strategy 命中的策略
+     * @param scan_steps 检查的分区数
+     * @param first_run 首段连续单元数
+     * @param fragments 段数
+     * @param size 对象大小
+     * @param leftover 相邻剩余空洞大小
+     */
+    void record(int tag, int timestamp, WriteStrategy strategy, int scan_steps,
+                int first_run, int fragments, int size, int leftover);
+
+    /**
+     * @brief 输出统计结果
+     * @param round 轮次
+     */
+    void dump(int round) const;
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 时间片耗时统计 ═══════════════════════════════╗*/
+/**
+ * @brief     时间片类别
+ */
+enum TickKind
+{
+    TK_NORMAL = 0,      // 普通时间片
+    TK_GC_PREPARE,      // GC预规划时间片
+    TK_GC,              // GC时间片
+    TK_NUM
+};
+
+inline const char* TICK_KIND_NAMES[TK_NUM] = {"normal", "gc_prepare", "gc"};
+
+/**
+ * @brief     时间片处理耗时统计
+ * @details   随Controller按轮重置:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. record: 每个时间片结束时记录该时间片的处理耗时(微秒)               │
+ * │ 2. dump: 每轮结束时按类别输出，每行形如                               │
+ * │    TICK_STATS round=1 kind=gc ticks=.. mean_us=.. p50_us=.. ...       │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class TickStats
+{
+public:
+    std::vector<int> micros[TK_NUM];    // 各类别的时间片耗时
+
+    /**
+     * @brief 记录一个时间片的耗时
+     * @param kind 时间片类别
+     * @param us 耗时(微秒)
+     */
+    void record(TickKind kind, int us) { micros[kind].push_back(us); }
+
+    /**
+     * @brief 输出统计结果
+     * @param round 轮次
+     */
+    void dump(int round) const;
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 请求时延直方图 ═══════════════════════════════╗*/
+// 时延分桶：0..LATENCY_BUCKETS-1个时间片各占一桶，更长的计入最后一桶
+inline const int LATENCY_BUCKETS = EXTRA_TIME + 1;
+
+/**
+ * @brief     请求时延直方图
+ * @details   每个桶对应一个时间片时延，同时维护两套计数:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. window: 按LATENCY_DECAY每时间片衰减的窗口计数，供调度实时查询      │
+ * │    新样本权重按时间指数增长代替逐桶衰减，record为O(1)，权重过大时      │
+ * │    整体缩放；分位数只依赖桶间比例，不受缩放影响                       │
+ * │ 2. total: 本轮累计计数，随Controller按轮重置，供轮末导出              │
+ * │ 3. 分位数查询扫描固定的LATENCY_BUCKETS个桶，与样本数无关              │
+ * │ 4. 仅含定长数组，可直接写入状态快照                                   │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class LatencyHist
+{
+public:
+    double window[LATENCY_BUCKETS] = {0};       // 衰减窗口计数
+    double window_sum = 0;                      // 衰减窗口总计数
+    double weight = 1;                          // 当前时间片新样本的权重
+    int weight_time = 0;                        // 权重对应的时间片
+    long long total[LATENCY_BUCKETS] = {0};     // 本轮累计计数
+    long long total_count = 0;                  // 本轮累计样本数
+    long long total_sum = 0;                    // 本轮累计时延和
+
+    /**
+     * @brief 记录一个完成请求的时延
+     * @param latency 时延(时间片)
+     * @param timestamp 当前时间片
+     */
+    void record(int latency, int timestamp)
+    {
+        // ◆ 推进权重，过大时整体缩放
+        if (timestamp != weight_time)
+        {
+            weight *= std::pow(1.0 / LATENCY_DECAY, timestamp - weight_time);
+            weight_time = timestamp;
+        }
+        if (weight > 1e100)
+        {
+            for (double &count : window) count /= weight;
+            window_sum /= weight;
+            weight = 1;
+        }
+
+        // ◆ 计入两套计数
+        int bucket = std::max(0, std::min(latency, LATENCY_BUCKETS - 1));
+        window[bucket] += weight;
+        window_sum += weight;
+        total[bucket]++;
+        total_count++;
+        total_sum += latency;
+    }
+
+    /**
+     * @brief 查询衰减窗口的时延分位数
+     * @param p 分位(0~1)
+     * @return 时延(时间片)，无样本时返回0
+     */
+    int percentile(double p) const
+    {
+        double target = p * window_sum, sum = 0;
+        for (int bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+        {
+            sum += window[bucket];
+            if (sum >= target and sum > 0) return bucket;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief 查询本轮累计的时延分位数
+     * @param p 分位(0~1)
+     * @return 时延(时间片)，无样本时返回0
+     */
+    int total_percentile(double p) const
+    {
+        long long target = std::ceil(p * total_count), sum = 0;
+        for (int bucket = 0; bucket < LATENCY_BUCKETS; ++bucket)
+        {
+            sum += total[bucket];
+            if (sum >= target and sum > 0) return bucket;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief 输出本轮累计的时延分布
+     * @param round 轮次
+     * @param scope 统计范围(disk、head或tag)
+     * @param id 范围内编号
+     * @param sub 子编号(磁头号)，小于0时不输出
+     */
+    void dump(int round, const char *scope, int id, int sub = -1) const;
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 时间预算 ═══════════════════════════════╗*/
+/**
+ * @brief     计时阶段
+ */
+enum TimePhase
+{
+    TP_DELETE = 0,      // 时间戳与删除
+    TP_WRITE,           // 写入
+    TP_READ,            // 读取
+    TP_BUSY,            // 繁忙上报
+    TP_GC,              // GC预规划与GC
+    TP_NUM
+};
+
+inline const char* TIME_PHASE_NAMES[TP_NUM] = {"delete", "write", "read", "busy", "gc"};
+
+/**
+ * @brief     降级等级
+ * @details   等级越高越省时，每级包含前一级的全部降级:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ DL_FULL: 全部策略                                                    │
+ * │ DL_LIGHT: GC候选只试运行满预算，跳过热度聚簇，子集匹配候选数受限      │
+ * │ DL_GREEDY: 不做GC预规划与收益规划，直接按贪心阶段执行GC；读取前置过滤 │
+ * │            不做完成时间预测，请求全部接受(到达率照常更新)             │
+ * │ DL_MINIMAL: GC只执行一对多交换，跳过多对多、边界迁移、聚拢与备份压缩  │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+enum DegradeLevel
+{
+    DL_FULL = 0,
+    DL_LIGHT,
+    DL_GREEDY,
+    DL_MINIMAL,
+    DL_NUM
+};
+
+inline const char* DEGRADE_LEVEL_NAMES[DL_NUM] = {"full", "light", "greedy", "minimal"};
+
+/**
+ * @brief     时间片与阶段时间预算
+ * @details   随Controller按轮重置，每轮计划TIME_BUDGET_ROUND_MS:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. start_tick/lap: 单调时钟计时，lap把上次标记以来的耗时计入阶段      │
+ * │    (含等待判题器发送该阶段输入的时间)                                │
+ * │ 2. end_tick: 累计耗时超过计划×TIME_STEP_DOWN_RATE时降一级，低于      │
+ * │    计划×TIME_STEP_UP_RATE时升一级，两次切换至少间隔TIME_SWITCH_HOLD   │
+ * │    个时间片；单个时间片超过TIME_BUDGET_TICK_MS时立即降一级            │
+ * │ 3. 每次切换输出一行BUDGET_SWITCH，轮末dump输出各阶段累计耗时          │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class TimeBudget
+{
+public:
+    int level = DL_FULL;                // 当前降级等级
+    double phase_ms[TP_NUM] = {};       // 本轮各阶段累计耗时
+    double round_ms = 0;                // 本轮累计耗时
+    double tick_ms = 0;                 // 当前时间片耗时
+    int last_switch = 0;                // 上次切换的时间片
+    int switches = 0;                   // 本轮切换次数
+
+    /**
+     * @brief 开始一个时间片的计时
+     */
+    void start_tick()
+    {
+        tick_ms = 0;
+        mark = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief 把上次标记以来的耗时计入阶段
+     * @param phase 阶段
+     */
+    void lap(TimePhase phase)
+    {
+        auto now = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(now - mark).count();
+        mark = now;
+        phase_ms[phase] += ms;
+        tick_ms += ms;
+        round_ms += ms;
+    }
+
+    /**
+     * @brief 结束时间片并按累计耗时调整降级等级
+     * @param round 轮次
+     * @param timestamp 本轮内时间戳
+     * @param round_ticks 每轮时间片数
+     */
+    void end_tick(int round, int timestamp, int round_ticks);
+
+    /**
+     * @brief 输出本轮各阶段累计耗时
+     * @param round 轮次
+     */
+    void dump(int round) const;
+
+private:
+    std::chrono::steady_clock::time_point mark;     // 上次标记时刻
+
+    /**
+     * @brief 切换降级等级并记录日志
+     */
+    void _switch(int round, int timestamp, int new_level, double plan_ms, const char *reason);
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
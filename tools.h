@@ -20,7 +20,15 @@
 #pragma once
 #include <cstdint>
 #include <cstddef>
+#include <climits>
 #include <iterator>
+#include <vector>
+#include <unordered_map>
+#include <bitset>
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
 
 /*╔══════════════════════════════ Int3Set类定义 ═══════════════════════════════╗*/
 /**
@@ -278,4 +286,373 @@ public:
         bits &= other.bits;
     }
 };
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ IndexedSet类定义 ═══════════════════════════════╗*/
+/**
+ * @brief     带引用计数的索引集合
+ * @details   用于增量维护分区内的外来对象(一个对象可有多个单元落在同一分区):
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ ● 元素按首次加入顺序存放于vector，遍历顺序稳定                        │
+ * │ ● 哈希表记录元素下标与引用计数，插入/删除/查找均为O(1)               │
+ * │ ● 计数归零时原位置留下墓碑，遍历跳过；移除不移动其他元素              │
+ * │ ● 墓碑多于存活元素时，在下一次加入前压缩，保持相对顺序                │
+ * │ ● 遍历期间可删除元素，但不可加入元素(加入可能触发压缩)                │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class IndexedSet {
+private:
+    static const int TOMBSTONE = INT_MIN;               // 墓碑标记
+    std::vector<int> items_;                            // 元素存储(含墓碑)
+    std::unordered_map<int, std::pair<int, int>> slots_; // 元素 -> (下标, 引用计数)
+
+    /**
+     * @brief     移除墓碑并重建下标，元素相对顺序不变
+     */
+    void _compact() {
+        size_t keep = 0;
+        for (int value : items_) {
+            if (value == TOMBSTONE) continue;
+            slots_[value].first = static_cast<int>(keep);
+            items_[keep++] = value;
+        }
+        items_.resize(keep);
+    }
+
+public:
+    /**
+     * @brief     跳过墓碑的只读迭代器
+     */
+    class const_iterator {
+    private:
+        std::vector<int>::const_iterator cur_, end_;
+        void _skip() { while (cur_ != end_ && *cur_ == TOMBSTONE) ++cur_; }
+    public:
+        const_iterator(std::vector<int>::const_iterator cur, std::vector<int>::const_iterator end)
+            : cur_(cur), end_(end) { _skip(); }
+        const int& operator*() const { return *cur_; }
+        const_iterator& operator++() { ++cur_; _skip(); return *this; }
+        bool operator!=(const const_iterator& other) const { return cur_ != other.cur_; }
+        bool operator==(const const_iterator& other) const { return cur_ == other.cur_; }
+    };
+
+    /**
+     * @brief     增加元素引用
+     * @param     value 元素
+     * @param     refs 增加的引用数
+     * @return    true表示新加入集合
+     */
+    bool add(int value, int refs = 1) {
+        auto it = slots_.find(value);
+        if (it != slots_.end()) {
+            it->second.second += refs;
+            return false;
+        }
+        if (items_.size() > 2 * slots_.size() + 16) _compact();
+        slots_.emplace(value, std::make_pair(static_cast<int>(items_.size()), refs));
+        items_.push_back(value);
+        return true;
+    }
+
+    /**
+     * @brief     减少元素引用
+     * @param     value 元素
+     * @return    true表示已移出集合
+     */
+    bool remove(int value) {
+        auto it = slots_.find(value);
+        if (it == slots_.end()) return false;
+        if (--it->second.second > 0) return false;
+
+        items_[it->second.first] = TOMBSTONE;
+        slots_.erase(it);
+        return true;
+    }
+
+    /**
+     * @brief     检查是否包含元素
+     */
+    bool contains(int value) const {
+        return slots_.count(value) != 0;
+    }
+
+    /**
+     * @brief     获取元素的引用计数，不存在时为0
+     */
+    int count(int value) const {
+        auto it = slots_.find(value);
+        return it == slots_.end() ? 0 : it->second.second;
+    }
+
+    /**
+     * @brief     获取元素列表(按加入顺序的副本)
+     */
+    std::vector<int> items() const {
+        std::vector<int> result;
+        result.reserve(slots_.size());
+        for (int value : *this) result.push_back(value);
+        return result;
+    }
+
+    size_t size() const { return slots_.size(); }
+    bool empty() const { return slots_.empty(); }
+    const_iterator begin() const { return const_iterator(items_.begin(), items_.end()); }
+    const_iterator end() const { return const_iterator(items_.end(), items_.end()); }
+
+    /**
+     * @brief     清空集合
+     */
+    void clear() {
+        items_.clear();
+        slots_.clear();
+    }
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ SubsetMatcher类定义 ═══════════════════════════════╗*/
+/**
+ * @brief     有界背包子集和匹配器
+ * @details   针对1-5大小对象的GC匹配，可复用以避免每次分配DP表:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ ● 按大小分桶计数，空闲单元视为大小1的特殊项(ID为-1)                   │
+ * │ ● 位集二进制拆分移位，一次求出所有可达和(上限MAX_SUM)                 │
+ * │ ● 每个大小保留一层可达位集，逐层回溯重建选择，无需n×target二维表      │
+ * │ ● 重建时优先使用大对象，空闲单元最后补足                             │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class SubsetMatcher {
+public:
+    static const int MAX_ITEM_SIZE = 5;         // 最大对象大小
+    static const int MAX_SUM = 127;             // 可达和上限(K ≤ 100)
+    using Bits = std::bitset<MAX_SUM + 1>;
+
+private:
+    std::vector<int> buckets_[MAX_ITEM_SIZE + 1];   // 按大小分桶的对象ID
+    int free_count_ = 0;                            // 空闲单元数
+    Bits stages_[MAX_ITEM_SIZE + 1];                // stages_[0]:仅空闲单元, stages_[s]:加入大小≤s的对象
+
+public:
+    /**
+     * @brief     清空候选(保留桶容量)
+     */
+    void reset() {
+        for (auto &bucket : buckets_) bucket.clear();
+        free_count_ = 0;
+    }
+
+    /**
+     * @brief     加入候选对象
+     * @param     size 对象大小[1-5]
+     * @param     id 对象ID
+     */
+    void add(int size, int id) {
+        assert(size >= 1 and size <= MAX_ITEM_SIZE);
+        buckets_[size].push_back(id);
+    }
+
+    /**
+     * @brief     设置可用于填充的空闲单元数
+     */
+    void set_free(int count) {
+        free_count_ = count;
+    }
+
+    /**
+     * @brief     计算所有可达和
+     * @return    可达和位集，第t位为1表示可组成大小t
+     */
+    const Bits& build() {
+        stages_[0].reset();
+        stages_[0].set(0);
+        _expand(stages_[0], 1, free_count_);
+        for (int s = 1; s <= MAX_ITEM_SIZE; ++s) {
+            stages_[s] = stages_[s - 1];
+            _expand(stages_[s], s, static_cast<int>(buckets_[s].size()));
+        }
+        return stages_[MAX_ITEM_SIZE];
+    }
+
+    /**
+     * @brief     回溯重建组成目标大小的选择(需先build)
+     * @param     target 目标大小
+     * @param     ids 输出：选中的对象ID(追加)
+     * @param     free_used 输出：使用的空闲单元数
+     * @return    true表示可组成
+     */
+    bool reconstruct(int target, std::vector<int>& ids, int& free_used) const {
+        if (target < 0 or target > MAX_SUM or !stages_[MAX_ITEM_SIZE][target]) return false;
+        int remain = target;
+        for (int s = MAX_ITEM_SIZE; s >= 1; --s) {
+            int take = std::min(static_cast<int>(buckets_[s].size()), remain / s);
+            while (take > 0 and !stages_[s - 1][remain - s * take]) take--;
+            ids.insert(ids.end(), buckets_[s].begin(), buckets_[s].begin() + take);
+            remain -= s * take;
+        }
+        assert(remain <= free_count_);
+        free_used = remain;
+        return true;
+    }
+
+private:
+    /**
+     * @brief     有界扩展：加入count个大小为size的项(二进制拆分)
+     */
+    static void _expand(Bits& reach, int size, int count) {
+        for (int chunk = 1; count > 0; chunk <<= 1) {
+            int k = std::min(chunk, count);
+            if (size * k > MAX_SUM) break;
+            reach |= reach << (size * k);
+            count -= k;
+        }
+    }
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ PendingBitmap类定义 ═══════════════════════════════╗*/
+/**
+ * @brief     待读单元位图
+ * @details   每个单元一位，标记该单元是否有未完成请求，支持O(1)区间计数:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ ● 置位/清位只改一个64位字，并标记前缀计数失效                          │
+ * │ ● 查询时若失效则按字重建前缀计数(每磁盘约V/64次加法)                  │
+ * │ ● 区间计数 = 两端前缀计数之差，端点所在字用掩码popcount               │
+ * │ ● 同一时间片内先集中更新、后集中查询时，每时间片至多重建一次           │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class PendingBitmap {
+private:
+    std::vector<uint64_t> words_;   // 位图
+    mutable std::vector<int> prefix_;   // prefix_[i]为前i个字的置位总数(查询时惰性重建)
+    mutable bool dirty_ = false;        // 前缀计数是否失效
+
+public:
+    /**
+     * @brief     清空并按单元数重新分配
+     * @param     size 最大单元编号
+     */
+    void reset(int size) {
+        words_.assign(size / 64 + 2, 0);
+        prefix_.assign(words_.size() + 1, 0);
+        dirty_ = false;
+    }
+
+    void set(int pos) {
+        words_[pos >> 6] |= uint64_t(1) << (pos & 63);
+        dirty_ = true;
+    }
+
+    void clear(int pos) {
+        words_[pos >> 6] &= ~(uint64_t(1) << (pos & 63));
+        dirty_ = true;
+    }
+
+    bool test(int pos) const {
+        return words_[pos >> 6] >> (pos & 63) & 1;
+    }
+
+    /**
+     * @brief     统计闭区间[lo, hi]内的置位数
+     */
+    int count(int lo, int hi) const {
+        if (lo > hi) return 0;
+        if (dirty_) _rebuild();
+        return _rank(hi + 1) - _rank(lo);
+    }
+
+private:
+    /**
+     * @brief     位置pos之前的置位数
+     */
+    int _rank(int pos) const {
+        uint64_t mask = (uint64_t(1) << (pos & 63)) - 1;
+        return prefix_[pos >> 6] + static_cast<int>(std::bitset<64>(words_[pos >> 6] & mask).count());
+    }
+
+    void _rebuild() const {
+        for (size_t i = 0; i < words_.size(); ++i) {
+            prefix_[i + 1] = prefix_[i] + static_cast<int>(std::bitset<64>(words_[i]).count());
+        }
+        dirty_ = false;
+    }
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 状态快照读写器 ═══════════════════════════════╗*/
+/**
+ * @brief     二进制状态快照写入器
+ * @details   按本机字节序把平凡可复制的值追加到内存缓冲区，最后一次性写出:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ ● 标量直接按字节追加                                                  │
+ * │ ● 数组先写元素个数(int)，再整体追加元素                               │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class StateWriter {
+public:
+    std::vector<char> buffer;   // 输出缓冲区
+
+    template<typename Type>
+    void put(const Type& value) {
+        static_assert(std::is_trivially_copyable<Type>::value, "state value must be trivially copyable");
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(Type));
+    }
+
+    template<typename Type>
+    void put_array(const Type* data, int count) {
+        static_assert(std::is_trivially_copyable<Type>::value, "state value must be trivially copyable");
+        put(count);
+        const char* bytes = reinterpret_cast<const char*>(data);
+        buffer.insert(buffer.end(), bytes, bytes + sizeof(Type) * count);
+    }
+
+    template<typename Type>
+    void put_vector(const std::vector<Type>& values) {
+        put_array(values.data(), static_cast<int>(values.size()));
+    }
+};
+
+/**
+ * @brief     二进制状态快照读取器
+ * @details   在只读内存(通常为mmap映射的文件)上顺序读取:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ ● 越界读取不抛异常，置ok为false并返回零值，由调用方最后统一检查       │
+ * │ ● 数组按元素个数一次memcpy到目标vector，不要求源地址对齐              │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+class StateReader {
+public:
+    const char* cursor;   // 当前读取位置
+    const char* end;      // 数据末尾
+    bool ok = true;       // 是否未发生越界
+
+    StateReader(const char* data, size_t size) : cursor(data), end(data + size) {}
+
+    template<typename Type>
+    Type get() {
+        static_assert(std::is_trivially_copyable<Type>::value, "state value must be trivially copyable");
+        Type value{};
+        if (not _take(sizeof(Type))) return value;
+        std::memcpy(&value, cursor - sizeof(Type), sizeof(Type));
+        return value;
+    }
+
+    template<typename Type>
+    void get_vector(std::vector<Type>& values) {
+        static_assert(std::is_trivially_copyable<Type>::value, "state value must be trivially copyable");
+        int count = get<int>();
+        if (count < 0 or not _take(sizeof(Type) * static_cast<size_t>(count))) count = 0;
+        values.resize(count);
+        if (count > 0) std::memcpy(values.data(), cursor - sizeof(Type) * count, sizeof(Type) * count);
+    }
+
+private:
+    bool _take(size_t bytes) {
+        if (not ok or static_cast<size_t>(end - cursor) < bytes) {
+            ok = false;
+            return false;
+        }
+        cursor += bytes;
+        return true;
+    }
+};
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
\ No newline at end of file
@@ -0,0 +1,378 @@
+/*━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ *   ██████╗ ███████╗███╗   ██╗
+ *  ██╔════╝ ██╔════╝████╗  ██║
+ *  ██║  ███╗█████╗  ██╔██╗ ██║
+ *  ██║   ██║██╔══╝  ██║╚██╗██║
+ *  ╚██████╔╝███████╗██║ ╚████║
+ *   ╚═════╝ ╚══════╝╚═╝  ╚═══╝
+ *
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━
+ * 【模块功能】
+ * ┌─────────────────┬───────────────────────────────────────────────────────────┐
+ * │ 负载合成         │ 按参数生成写入、删除、读取事件：标签构成、对象大小分布、     │
+ * │                 │ 寿命、读突发、热点倾斜与无标签对象比例                       │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 合法性           │ 三副本占用不超过总容量的fill比例(上限90%)，删除与读取只作用   │
+ * │                 │ 于存活对象，超出code_craft的MAX_*上限时给出警告              │
+ * ├─────────────────┼───────────────────────────────────────────────────────────┤
+ * │ 数据集输出       │ 与code_craft标准输入一致的两轮流，无标签对象的真实标签作为    │
+ * │                 │ 第二轮增量信息；另输出按真实标签统计的<out>.fre频率表         │
+ * └─────────────────┴───────────────────────────────────────────────────────────┘
+ *
+ * 【用法】
+ *   workload_gen --out <文件> [--key value]...
+ *   参数见print_usage；.fre按初赛格式为3×M行(删除、写入、读取)，每行⌈T/1800⌉个
+ *   对象块数，以-DFRE_FILE=\"<路径>\"编译的code_craft会以其替换内置频率表
+ * ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━*/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <queue>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*╔══════════════════════════════ 上限常量 ═══════════════════════════════╗*/
+// 与code_craft的constants.h一致，仅用于警告
+const int PLAYER_MAX_DISK = 10;
+const int PLAYER_MAX_DISK_SIZE = 16384;
+const int PLAYER_MAX_OBJECT = 100000;
+const int PLAYER_MAX_TAG = 16;
+const int PLAYER_MAX_G = 1000;
+const int PLAYER_MAX_T = 86400;
+const int EXTRA_TIME = 105;
+const int FRE_PER_SLICING = 1800;
+const int MAX_OBJ_SIZE = 5;
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 生成参数 ═══════════════════════════════╗*/
+/**
+ * @brief     生成参数
+ * @details   读、写速率为每时间片均值，实际取[0.5, 1.5]倍均匀分布:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 突发: 每burst_period个时间片中前burst_len个时间片读速率乘burst_mult   │
+ * │ 倾斜: 第k热的标签读权重 ∝ 1/k^skew，标签热度排名随机                  │
+ * │ 热点: 写入时以hot_frac概率标为热点，hot_share的读取落在热点对象上     │
+ * │ 寿命: 指数分布，均值lifetime；容量超限时随机删除存活对象              │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+struct GenConfig
+{
+    std::string out;                                    // 输出文件
+    unsigned long long seed = 1;
+    int T = 7200, M = 16, N = 10, V = 8000, G = 350, k1 = 40, k2 = 30;
+    double writes = 3.0;                                // 每时间片写入对象数均值
+    double reads = 25.0;                                // 每时间片读取请求数均值
+    double lifetime = 20000;                            // 对象寿命均值(时间片)
+    double fill = 0.6;                                  // 三副本占用容量比例上限
+    std::vector<double> size_weights = {36, 25, 22, 11, 6};
+    std::vector<double> tag_weights;                    // 写入标签权重，为空时均匀
+    double skew = 1.0;                                  // 标签读热度的Zipf指数
+    double hot_frac = 0.01;                             // 热点对象比例
+    double hot_share = 0.2;                             // 落在热点对象上的读比例
+    double untagged = 0.1;                              // 无标签对象比例
+    int burst_period = 0;                               // 突发周期，0表示无突发
+    int burst_len = 0;                                  // 突发持续时间片
+    double burst_mult = 1.0;                            // 突发读速率倍数
+};
+
+/**
+ * @brief     打印用法
+ */
+void print_usage()
+{
+    printf("usage: workload_gen --out <file> [options]\n"
+           "  --seed S --T T --M M --N N --V V --G G --k1 K1 --k2 K2\n"
+           "  --writes W          mean objects written per tick\n"
+           "  --reads R           mean read requests per tick\n"
+           "  --lifetime L        mean object lifetime in ticks\n"
+           "  --fill F            max fraction of disk space used by replicas (<=0.9)\n"
+           "  --size-weights a,b,c,d,e\n"
+           "  --tag-weights w1,...,wM\n"
+           "  --skew S            Zipf exponent of tag read popularity\n"
+           "  --hot-frac F        fraction of objects marked hot\n"
+           "  --hot-share F       fraction of reads going to hot objects\n"
+           "  --untagged F        fraction of objects written with tag 0\n"
+           "  --burst-period P --burst-len L --burst-mult X\n");
+}
+
+/**
+ * @brief     解析逗号分隔的权重
+ */
+std::vector<double> parse_weights(const char *text)
+{
+    std::vector<double> weights;
+    std::stringstream stream(text);
+    for (std::string item; std::getline(stream, item, ','); ) weights.push_back(std::atof(item.c_str()));
+    return weights;
+}
+
+/**
+ * @brief     解析命令行
+ * @return    参数合法时返回true
+ */
+bool parse_args(int argc, char **argv, GenConfig &config)
+{
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        std::string key = argv[i];
+        const char *value = argv[i + 1];
+        if (key == "--out") config.out = value;
+        else if (key == "--seed") config.seed = std::strtoull(value, nullptr, 10);
+        else if (key == "--T") config.T = std::atoi(value);
+        else if (key == "--M") config.M = std::atoi(value);
+        else if (key == "--N") config.N = std::atoi(value);
+        else if (key == "--V") config.V = std::atoi(value);
+        else if (key == "--G") config.G = std::atoi(value);
+        else if (key == "--k1") config.k1 = std::atoi(value);
+        else if (key == "--k2") config.k2 = std::atoi(value);
+        else if (key == "--writes") config.writes = std::atof(value);
+        else if (key == "--reads") config.reads = std::atof(value);
+        else if (key == "--lifetime") config.lifetime = std::atof(value);
+        else if (key == "--fill") config.fill = std::atof(value);
+        else if (key == "--size-weights") config.size_weights = parse_weights(value);
+        else if (key == "--tag-weights") config.tag_weights = parse_weights(value);
+        else if (key == "--skew") config.skew = std::atof(value);
+        else if (key == "--hot-frac") config.hot_frac = std::atof(value);
+        else if (key == "--hot-share") config.hot_share = std::atof(value);
+        else if (key == "--untagged") config.untagged = std::atof(value);
+        else if (key == "--burst-period") config.burst_period = std::atoi(value);
+        else if (key == "--burst-len") config.burst_len = std::atoi(value);
+        else if (key == "--burst-mult") config.burst_mult = std::atof(value);
+        else
+        {
+            fprintf(stderr, "unknown option %s\n", key.c_str());
+            return false;
+        }
+    }
+    if (argc % 2 == 0) return false;
+    if (config.tag_weights.empty()) config.tag_weights.assign(config.M, 1.0);
+    return not config.out.empty() and config.T > 0 and config.M > 0 and config.N >= 3 and config.V > 0 and
+           config.size_weights.size() == MAX_OBJ_SIZE and static_cast<int>(config.tag_weights.size()) == config.M;
+}
+
+/**
+ * @brief     超出code_craft上限时警告(仍然生成)
+ */
+void warn_limits(const GenConfig &config)
+{
+    auto warn = [](const char *name, int value, int limit) {
+        if (value > limit) fprintf(stderr, "warning: %s=%d exceeds code_craft limit %d\n", name, value, limit);
+    };
+    warn("T", config.T, PLAYER_MAX_T);
+    warn("M", config.M, PLAYER_MAX_TAG);
+    warn("N", config.N, PLAYER_MAX_DISK);
+    warn("V", config.V, PLAYER_MAX_DISK_SIZE);
+    warn("G", config.G, PLAYER_MAX_G);
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 存活对象集合 ═══════════════════════════════╗*/
+/**
+ * @brief     支持O(1)插入、删除与随机抽取的ID集合
+ */
+class LivePool
+{
+public:
+    std::vector<int> ids;
+
+    void add(int id, std::vector<int> &slot)
+    {
+        slot[id] = ids.size();
+        ids.push_back(id);
+    }
+
+    void remove(int id, std::vector<int> &slot)
+    {
+        int pos = slot[id];
+        slot[ids.back()] = pos;
+        ids[pos] = ids.back();
+        ids.pop_back();
+        slot[id] = -1;
+    }
+
+    int pick(std::mt19937_64 &rng) const
+    {
+        return ids[std::uniform_int_distribution<size_t>(0, ids.size() - 1)(rng)];
+    }
+};
+
+/**
+ * @brief     生成过程中的对象
+ */
+struct GenObject
+{
+    int size = 0;        // 大小，0表示已删除
+    int tag = 0;         // 真实标签
+    bool hot = false;    // 是否热点
+};
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 负载生成 ═══════════════════════════════╗*/
+/**
+ * @brief     生成数据集与频率表
+ * @return    输出成功返回true
+ */
+bool generate(const GenConfig &config)
+{
+    std::mt19937_64 rng(config.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    auto rate = [&](double mean) { return static_cast<int>(std::floor(mean * (0.5 + unit(rng)) + unit(rng))); };
+
+    // ◆ 分布
+    std::discrete_distribution<int> size_dist(config.size_weights.begin(), config.size_weights.end());
+    std::discrete_distribution<int> tag_dist(config.tag_weights.begin(), config.tag_weights.end());
+    std::exponential_distribution<double> life_dist(1.0 / std::max(1.0, config.lifetime));
+    std::vector<int> tag_rank(config.M);
+    for (int i = 0; i < config.M; ++i) tag_rank[i] = i + 1;
+    std::shuffle(tag_rank.begin(), tag_rank.end(), rng);
+    std::vector<double> tag_read_weight(config.M + 1, 0);
+    for (int k = 0; k < config.M; ++k) tag_read_weight[tag_rank[k]] = 1.0 / std::pow(k + 1, config.skew);
+
+    // ◆ 状态
+    long long capacity = static_cast<long long>(std::min(config.fill, 0.9) * config.N * config.V / 3);
+    long long live_units = 0;
+    std::vector<GenObject> objects(1);
+    std::vector<int> tag_slot(1, -1), hot_slot(1, -1);
+    std::vector<LivePool> tag_pool(config.M + 1);
+    LivePool hot_pool;
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, std::greater<>> deaths;
+    std::vector<std::pair<int, int>> incremental;
+    int slices = (config.T - 1) / FRE_PER_SLICING + 1;
+    std::vector<std::vector<long long>> fre(3, std::vector<long long>((config.M + 1) * slices, 0));
+    int next_req = 1;
+
+    auto remove_object = [&](int obj_id, int slice) {
+        GenObject &obj = objects[obj_id];
+        tag_pool[obj.tag].remove(obj_id, tag_slot);
+        if (obj.hot) hot_pool.remove(obj_id, hot_slot);
+        live_units -= obj.size;
+        fre[0][obj.tag * slices + slice] += obj.size;
+        obj.size = 0;
+    };
+
+    FILE *out = fopen(config.out.c_str(), "w");
+    if (not out) return false;
+    fprintf(out, "%d %d %d %d %d %d %d\n", config.T, config.M, config.N, config.V, config.G, config.k1, config.k2);
+
+    std::vector<int> deletes;
+    for (int t = 1; t <= config.T + EXTRA_TIME; ++t)
+    {
+        fprintf(out, "TIMESTAMP %d\n", t);
+        int slice = std::min((t - 1) / FRE_PER_SLICING, slices - 1);
+        bool active = t <= config.T;
+
+        // ◆ 删除：寿命到期，写入前容量不足时随机删除
+        deletes.clear();
+        while (active and not deaths.empty() and deaths.top().first <= t)
+        {
+            int obj_id = deaths.top().second;
+            deaths.pop();
+            if (objects[obj_id].size == 0) continue;
+            remove_object(obj_id, slice);
+            deletes.push_back(obj_id);
+        }
+        int n_write = active ? rate(config.writes) : 0;
+        while (active and live_units + n_write * MAX_OBJ_SIZE > capacity)
+        {
+            int tag = 1 + std::uniform_int_distribution<int>(0, config.M - 1)(rng);
+            if (tag_pool[tag].ids.empty()) continue;
+            int obj_id = tag_pool[tag].pick(rng);
+            remove_object(obj_id, slice);
+            deletes.push_back(obj_id);
+        }
+        fprintf(out, "%d\n", static_cast<int>(deletes.size()));
+        for (int obj_id : deletes) fprintf(out, "%d\n", obj_id);
+
+        // ◆ 写入
+        fprintf(out, "%d\n", n_write);
+        for (int i = 0; i < n_write; ++i)
+        {
+            int obj_id = objects.size();
+            GenObject obj;
+            obj.size = size_dist(rng) + 1;
+            obj.tag = tag_dist(rng) + 1;
+            obj.hot = unit(rng) < config.hot_frac;
+            objects.push_back(obj);
+            tag_slot.push_back(-1);
+            hot_slot.push_back(-1);
+            tag_pool[obj.tag].add(obj_id, tag_slot);
+            if (obj.hot) hot_pool.add(obj_id, hot_slot);
+            live_units += obj.size;
+            fre[1][obj.tag * slices + slice] += obj.size;
+            deaths.push({t + 1 + static_cast<int>(life_dist(rng)), obj_id});
+
+            bool untagged = unit(rng) < config.untagged;
+            if (untagged) incremental.push_back({obj_id, obj.tag});
+            fprintf(out, "%d %d %d\n", obj_id, obj.size, untagged ? 0 : obj.tag);
+        }
+
+        // ◆ 读取：突发倍率，热点对象或按标签热度选择
+        double read_mean = config.reads;
+        if (config.burst_period > 0 and (t - 1) % config.burst_period < config.burst_len) read_mean *= config.burst_mult;
+        int n_read = active ? rate(read_mean) : 0;
+        std::vector<double> weights(config.M + 1, 0);
+        for (int tag = 1; tag <= config.M; ++tag) weights[tag] = tag_pool[tag].ids.empty() ? 0 : tag_read_weight[tag];
+        bool any_live = std::any_of(weights.begin(), weights.end(), [](double w) { return w > 0; });
+        std::discrete_distribution<int> read_tag_dist(weights.begin(), weights.end());
+        std::vector<std::pair<int, int>> reads;
+        for (int i = 0; i < n_read and any_live; ++i)
+        {
+            int obj_id = not hot_pool.ids.empty() and unit(rng) < config.hot_share
+                       ? hot_pool.pick(rng) : tag_pool[read_tag_dist(rng)].pick(rng);
+            reads.push_back({next_req++, obj_id});
+            fre[2][objects[obj_id].tag * slices + slice] += objects[obj_id].size;
+        }
+        fprintf(out, "%d\n", static_cast<int>(reads.size()));
+        for (auto &[req_id, obj_id] : reads) fprintf(out, "%d %d\n", req_id, obj_id);
+
+        if (t % FRE_PER_SLICING == 0) fprintf(out, "GARBAGE COLLECTION\n");
+    }
+
+    // ◆ 第二轮：增量信息与时间戳(判题器会自行发送时间戳，直接重定向运行时需要)
+    fprintf(out, "%d\n", static_cast<int>(incremental.size()));
+    for (auto &[obj_id, tag] : incremental) fprintf(out, "%d %d\n", obj_id, tag);
+    for (int t = 1; t <= config.T + EXTRA_TIME; ++t) fprintf(out, "TIMESTAMP %d\n", t);
+    fclose(out);
+
+    // ◆ 频率表
+    FILE *fre_out = fopen((config.out + ".fre").c_str(), "w");
+    if (not fre_out) return false;
+    for (int kind = 0; kind < 3; ++kind)
+    {
+        for (int tag = 1; tag <= config.M; ++tag)
+        {
+            for (int s = 0; s < slices; ++s) fprintf(fre_out, s == 0 ? "%lld" : " %lld", fre[kind][tag * slices + s]);
+            fprintf(fre_out, "\n");
+        }
+    }
+    fclose(fre_out);
+
+    int objects_written = objects.size() - 1;
+    if (objects_written > PLAYER_MAX_OBJECT)
+    {
+        fprintf(stderr, "warning: %d objects exceed code_craft limit %d\n", objects_written, PLAYER_MAX_OBJECT);
+    }
+    fprintf(stderr, "objects=%d requests=%d untagged=%d\n", objects_written, next_req - 1,
+            static_cast<int>(incremental.size()));
+    return true;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
+/*╔══════════════════════════════ 主函数 ══════════════════════════════════╗*/
+int main(int argc, char **argv)
+{
+    GenConfig config;
+    if (not parse_args(argc, argv, config))
+    {
+        print_usage();
+        return 2;
+    }
+    warn_limits(config);
+    return generate(config) ? 0 : 1;
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
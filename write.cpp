@@ -33,6 +33,7 @@
 #include <iostream>
 #include <algorithm>
 #include <random>
+#include <cstdlib>
 
 /*╔══════════════════════════════ 写入控制模块 ═══════════════════════════════╗*/
 /**
@@ -59,7 +60,9 @@ Object *Controller::write(int obj_id, int obj_size, int tag)
     obj.id = obj_id;
 
     // ◆ 选择写入位置
-    auto space = _get_write_disk(obj_size, tag);
+    WriteStrategy strategy = WS_OWN;
+    int scan_steps = 0;
+    auto space = _get_write_disk(obj_size, tag, strategy, scan_steps);
 
     // ◆ 准备单元ID列表
     std::vector<int> units;
@@ -77,6 +80,9 @@ Object *Controller::write(int obj_id, int obj_size, int tag)
         obj.replicas[i].second.insert(obj.replicas[i].second.end(), pos.begin(), pos.end());
     }
 
+    // ◆ 记录主副本放置统计
+    _record_write_stats(obj, strategy, scan_steps);
+
     return &obj;
 }
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
@@ -94,7 +100,8 @@ Object *Controller::write(int obj_id, int obj_size, int tag)
  * │ 3. 在其他磁盘中选择备份区域                                           │
  * └──────────────────────────────────────────────────────────────────────┘
  */
-std::vector<std::pair<int, Part *>> Controller::_get_write_disk(int obj_size, int tag)
+std::vector<std::pair<int, Part *>> Controller::_get_write_disk(int obj_size, int tag, 
+                                                                 WriteStrategy &strategy, int &scan_steps)
 {
     std::vector<std::pair<int, Part *>> space;
 
@@ -128,26 +135,25 @@ std::vector<std::pair<int, Part *>> Controller::_get_write_disk(int obj_size, in
             // ● 检查同标签分区
             for (auto &part : DISKS[disk_id].get_parts(tag))
             {
+                scan_steps++;
                 if (part.free_cells < obj_size) continue;
                 
-                // ● 查找精确匹配的空闲块
-                FreeBlock *current = part.free_list_head;
-                while (current != nullptr)
+                // ● 通过大小索引查找精确匹配的空闲块
+                auto it = part.size_index.lower_bound({obj_size, 0});
+                if (it != part.size_index.end() && it->first.first == obj_size)
                 {
-                    if (current->end - current->start + 1 == obj_size)
-                    {
-                        space.push_back({disk_id, &part});
-                        goto find_back;
-                    }
-                    current = current->next;
+                    space.push_back({disk_id, &part});
+                    strategy = WS_EXACT;
+                    goto find_back;
                 }
             }
         }
     }
 
     // ◆ 策略2: 根据标签优先级查找
-    for (int tag_ : tag_list)
+    for (size_t list_idx = 0; list_idx < tag_list.size(); ++list_idx)
     {
+        int tag_ = tag_list[list_idx];
         for (int i = 1 + disk_start; i <= N + disk_start; ++i)
         {
             int disk_id = (i - 1) % N + 1;
@@ -161,9 +167,15 @@ std::vector<std::pair<int, Part *>> Controller::_get_write_disk(int obj_size, in
 
                 // ● 检查空闲空间
                 Part &part = parts[part_idx];
+                scan_steps++;
                 if (part.free_cells >= obj_size)
                 {
                     space.push_back({disk_id, &part});
+                    strategy = list_idx == 0 ? WS_OWN
+                             : list_idx == 1 ? WS_REVERSE
+                             : tag_list[list_idx] == 17 ? WS_REDUNDANT
+                             : tag_list[list_idx] == WRITE_START ? WS_WRITE_START
+                             : WS_SIMILAR;
                     goto find_back;
                 }
             }
@@ -197,6 +209,47 @@ std::vector<std::pair<int, Part *>> Controller::_get_write_disk(int obj_size, in
 }
 /*╚═════════════════════════════════════════════════════════════════════════╝*/
 
+/*╔══════════════════════════════ 写入统计模块 ═══════════════════════════════╗*/
+/**
+ * @brief     记录对象主副本的放置结果
+ * @param     obj 已写入的对象
+ * @param     strategy 命中的策略
+ * @param     scan_steps 检查的分区数
+ * @details   统计以下信息:
+ * ┌──────────────────────────────────────────────────────────────────────┐
+ * │ 1. 段数：主副本单元位置中不连续的段数，及首段外的单元数               │
+ * │ 2. 剩余空洞：对象两侧同分区内相邻的空闲单元数，超过分桶上界即停止     │
+ * └──────────────────────────────────────────────────────────────────────┘
+ */
+void Controller::_record_write_stats(const Object &obj, WriteStrategy strategy, int scan_steps)
+{
+    auto &[disk_id, pos] = obj.replicas[0];
+    Disk &disk = DISKS[disk_id];
+
+    // ◆ 统计段数
+    int fragments = 1;
+    int first_run = 1;
+    for (size_t i = 1; i < pos.size(); ++i)
+    {
+        if (std::abs(pos[i] - pos[i - 1]) != 1) fragments++;
+        else if (fragments == 1) first_run++;
+    }
+
+    // ◆ 统计相邻剩余空洞
+    const int hole_cap = WRITE_HOLE_BOUNDS[WRITE_HOLE_BUCKETS - 2] + 1;
+    Part *part = disk.cells[pos[0]].part;
+    int lo = *std::min_element(pos.begin(), pos.end());
+    int hi = *std::max_element(pos.begin(), pos.end());
+    int leftover = 0;
+    for (int i = lo - 1; i >= 1 and leftover < hole_cap and disk.cells[i].part == part 
+                                  and disk.cells[i].obj_id == 0; --i) leftover++;
+    for (int i = hi + 1; i <= disk.size and leftover < hole_cap and disk.cells[i].part == part 
+                                          and disk.cells[i].obj_id == 0; ++i) leftover++;
+
+    write_stats.record(obj.tag, timestamp, strategy, scan_steps, first_run, fragments, obj.size, leftover);
+}
+/*╚═════════════════════════════════════════════════════════════════════════╝*/
+
 /*╔══════════════════════════════ 磁盘写入模块 ═══════════════════════════════╗*/
 /**
  * @brief     将对象写入指定磁盘分区
@@ -208,9 +261,9 @@ std::vector<std::pair<int, Part *>> Controller::_get_write_disk(int obj_size, in
  * @details   执行以下策略:
  * ┌──────────────────────────────────────────────────────────────────────┐
  * │ 1. 确定写入方向                                                       │
- * │ 2. 寻找最优空闲块                                                     │
- * │ 3. 执行写入操作                                                       │
- * │ 4. 更新分区状态                                                       │
+ * │ 2. 数据区：由分区分配连续区段(本标签最佳匹配，外来对象沿方向首个匹配)  │
+ * │ 3. 备份区：按大小索引最佳匹配连续区段，由GC向压缩端聚拢               │
+ * │ 4. 执行写入并更新分区状态                                             │
  * └──────────────────────────────────────────────────────────────────────┘
  */
 std::vector<int> Disk::write(int obj_id, const std::vector<int> &units, int tag, Part *part)
@@ -224,65 +277,42 @@ std::vector<int> Disk::write(int obj_id, const std::vector<int> &units, int tag,
         is_reverse = part->start > part->end;
     }
     
-    // ◆ 获取分区范围
-    int start = std::min(part->start, part->end);
-    int end = std::max(part->start, part->end);
-    
-    // ◆ 寻找最优写入位置
-    int pointer = 0;
-    int min_diff = 99999;
-    
-    // ● 对于标签匹配的非备份区，寻找最优空闲块
-    if (part->tag == tag && part->tag != 0)
+    // ◆ 确定写入位置
+    std::vector<int> result;
+    if (part->tag != 0)
     {
-        FreeBlock *current = is_reverse ? part->free_list_tail : part->free_list_head;
-        while (current != nullptr) 
-        {
-            if (current->end - current->start + 1 >= units.size()) 
-            {
-                int diff = current->end - current->start + 1 - units.size();
-                if (diff < min_diff) 
-                {
-                    min_diff = diff;
-                    pointer = is_reverse ? current->end : current->start;
-                }
-            }
-            current = is_reverse ? current->prev : current->next;
-        }
+        // ● 数据区：连续区段分配，空间不足时最少碎片拆分
+        result = part->allocate_run(units.size(), is_reverse, part->tag != tag);
     }
-    
-    // ● 如果没找到合适的空闲块，从分区边界开始
-    if (pointer == 0) 
+    else
     {
-        pointer = is_reverse ? end : start;
+        // ● 备份区：最佳匹配的连续区段，同长度时靠近压缩端
+        result = part->allocate_run(units.size(), is_reverse, false);
     }
     
     // ◆ 执行写入操作
-    std::vector<int> result;
-    for (int unit_id : units)
+    for (size_t i = 0; i < units.size(); ++i)
     {
-        // ● 寻找空闲单元
-        while (cells[pointer].obj_id != 0) 
-        {
-            pointer = is_reverse ? pointer - 1 : pointer + 1;
-        }
-        
-        // ● 写入数据
-        cells[pointer].obj_id = obj_id;
-        cells[pointer].unit_id = unit_id;
-        cells[pointer].tag = tag;
-        cells[pointer].part = part;
+        int pos = result[i];
+        assert(cells[pos].obj_id == 0);
+        cells[pos].obj_id = obj_id;
+        cells[pos].unit_id = units[i];
+        cells[pos].tag = tag;
+        cells[pos].part = part;
         part->free_cells--;
-        
-        // ● 更新空闲块链表
-        if (part->tag != 0) 
+        _track_other_obj(pos);
+    }
+    mark_gc_dirty(part);
+
+    // ◆ 本标签分区将满时，向尾部相对的邻居迁移边界
+    if (part->tag != 0)
+    {
+        for (auto &own_part : get_parts(tag))
         {
-            part->allocate_block(pointer);
+            _part_migrate_boundary(own_part);
         }
-        
-        result.push_back(pointer);
     }
-    
+
     return result;
 }
-/*╚═════════════════════════════════════════════════════════════════════════╝*/
\ No newline at end of file
+/*╚═════════════════════════════════════════════════════════════════════════╝*/